@@ -0,0 +1,520 @@
+/*
+ * Bancada de desempenho reprodutível para os três resolvedores:
+ * shsup (C++), shortest_superstring (sequencial) e
+ * shortest_superstring_parallel (OpenMP).
+ *
+ * Para cada combinação de número de leituras e comprimento de leitura é
+ * gerada uma entrada sintética (leituras distintas amostradas de um genoma
+ * aleatório, com semente fixa). Cada resolvedor roda como processo filho;
+ * são medidos o tempo de parede, o pico de memória residente (wait4) e os
+ * tempos de fase que o próprio resolvedor imprime em stderr
+ * ("<fase>: <segundos> segundos"). A saída de cada execução é comparada
+ * com a da primeira execução da mesma entrada.
+ *
+ * Resultados em CSV (uma linha por execução) e JSON.
+ *
+ * Ex.: ./shsup_bench --n=500,1000 --len=50,100 --threads=1,2,4 --runs=3
+ */
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_LIST 32
+#define MAX_SOLVERS 16
+#define MAX_PHASES 8
+#define MAX_ARGS 32
+
+/**
+ * @brief Um resolvedor a ser medido: executável e argumentos extras.
+ */
+typedef struct {
+    char label[128];
+    char path[512];
+    char* args[MAX_ARGS];
+    int num_args;
+    bool threaded;      // varia OMP_NUM_THREADS; os demais rodam só com 1 thread
+    bool small_only;    // só roda até --shsup-max-n leituras
+} solver_t;
+
+typedef struct {
+    char name[96];
+    double seconds;
+} phase_t;
+
+/**
+ * @brief Resultado de uma execução.
+ */
+typedef struct {
+    double wall;
+    long max_rss_kb;
+    int exit_code;
+    int num_phases;
+    phase_t phases[MAX_PHASES];
+} run_result_t;
+
+typedef struct {
+    int n[MAX_LIST], num_n;
+    int len[MAX_LIST], num_len;
+    int threads[MAX_LIST], num_threads;
+    int runs;
+    uint64_t seed;
+    double coverage;
+    int shsup_max_n;
+    const char* bin_dir;
+    const char* work_dir;
+    const char* csv_path;
+    const char* json_path;
+    const char* solvers;
+    char* par_args[MAX_SOLVERS];
+    int num_par_args;
+} bench_options_t;
+
+static uint64_t rng_state;
+
+static uint64_t rng_next(void) {
+    // xorshift64*
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Lê uma lista "a,b,c" de inteiros positivos.
+ */
+static bool parse_int_list(const char* s, int* out, int* count) {
+    *count = 0;
+    while (*s) {
+        char* end;
+        long v = strtol(s, &end, 10);
+        if (end == s || v <= 0 || *count == MAX_LIST) return false;
+        out[(*count)++] = (int)v;
+        s = end;
+        if (*s == ',') s++;
+        else if (*s) return false;
+    }
+    return *count > 0;
+}
+
+/**
+ * @brief Gera 'n' leituras distintas de comprimento 'len' amostradas de um
+ * genoma aleatório com cobertura aproximada 'coverage'.
+ */
+static bool write_input(const char* path, int n, int len, double coverage, uint64_t seed) {
+    long long genome_len = (long long)((double)n * len / coverage);
+    if (genome_len < 2LL * n + len) genome_len = 2LL * n + len;
+    long long positions = genome_len - len + 1;
+
+    char* genome = malloc(genome_len);
+    unsigned char* used = calloc(positions, 1);
+    FILE* f = fopen(path, "w");
+    if (genome == NULL || used == NULL || f == NULL) {
+        fprintf(stderr, "Falha ao gerar %s\n", path);
+        free(genome);
+        free(used);
+        if (f) fclose(f);
+        return false;
+    }
+
+    rng_state = seed * 0x9E3779B97F4A7C15ULL + (uint64_t)n * 1315423911u + len;
+    if (rng_state == 0) rng_state = 1;
+    for (long long k = 0; k < genome_len; ++k) genome[k] = "ACGT"[rng_next() >> 62];
+
+    fprintf(f, "%d\n", n);
+    for (int i = 0; i < n; ++i) {
+        long long p;
+        do {
+            p = (long long)(rng_next() % (uint64_t)positions);
+        } while (used[p]);
+        used[p] = 1;
+        fwrite(genome + p, 1, len, f);
+        fputc('\n', f);
+    }
+
+    fclose(f);
+    free(genome);
+    free(used);
+    return true;
+}
+
+/**
+ * @brief Extrai de stderr as linhas "<fase>: <segundos> segundos".
+ */
+static void parse_phases(const char* err_path, run_result_t* r) {
+    FILE* f = fopen(err_path, "r");
+    if (f == NULL) return;
+    char line[512];
+    while (fgets(line, sizeof line, f) && r->num_phases < MAX_PHASES) {
+        char* colon = strstr(line, ": ");
+        if (colon == NULL || strstr(colon, " segundos") == NULL) continue;
+        char* end;
+        double v = strtod(colon + 2, &end);
+        if (end == colon + 2) continue;
+        phase_t* ph = &r->phases[r->num_phases++];
+        size_t k = colon - line;
+        if (k >= sizeof ph->name) k = sizeof ph->name - 1;
+        memcpy(ph->name, line, k);
+        ph->name[k] = '\0';
+        ph->seconds = v;
+    }
+    fclose(f);
+}
+
+/**
+ * @brief Roda um resolvedor como processo filho com a entrada em stdin.
+ */
+static bool run_solver(const solver_t* s, int threads, const char* in_path,
+                       const char* out_path, const char* err_path, run_result_t* r) {
+    char* argv[MAX_ARGS + 2];
+    argv[0] = (char*)s->path;
+    for (int k = 0; k < s->num_args; ++k) argv[k + 1] = s->args[k];
+    argv[s->num_args + 1] = NULL;
+
+    memset(r, 0, sizeof *r);
+    double start = now_seconds();
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return false;
+    }
+    if (pid == 0) {
+        char value[16];
+        snprintf(value, sizeof value, "%d", threads);
+        setenv("OMP_NUM_THREADS", value, 1);
+        int in = open(in_path, O_RDONLY);
+        int out = open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        int err = open(err_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (in < 0 || out < 0 || err < 0) _exit(126);
+        dup2(in, STDIN_FILENO);
+        dup2(out, STDOUT_FILENO);
+        dup2(err, STDERR_FILENO);
+        execv(argv[0], argv);
+        _exit(127);
+    }
+
+    int status;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) < 0) {
+        perror("wait4");
+        return false;
+    }
+    r->wall = now_seconds() - start;
+    r->max_rss_kb = usage.ru_maxrss;
+    r->exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    parse_phases(err_path, r);
+    return true;
+}
+
+static char* read_file(const char* path, size_t* size) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) return NULL;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* data = malloc(n + 1);
+    *size = fread(data, 1, n, f);
+    fclose(f);
+    return data;
+}
+
+static bool same_file(const char* a, const char* b) {
+    size_t na, nb;
+    char* da = read_file(a, &na);
+    char* db = read_file(b, &nb);
+    bool same = da && db && na == nb && memcmp(da, db, na) == 0;
+    free(da);
+    free(db);
+    return same;
+}
+
+static bool copy_file(const char* from, const char* to) {
+    size_t n;
+    char* data = read_file(from, &n);
+    FILE* f = fopen(to, "wb");
+    bool ok = data && f && fwrite(data, 1, n, f) == n;
+    if (f) fclose(f);
+    free(data);
+    return ok;
+}
+
+static void json_string(FILE* f, const char* s) {
+    fputc('"', f);
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+static void print_usage(const char* program) {
+    fprintf(stderr,
+            "Uso: %s [opções]\n"
+            "  --n=LISTA            números de leituras (padrão: 500,1000,2000)\n"
+            "  --len=LISTA          comprimentos de leitura (padrão: 50,100)\n"
+            "  --threads=LISTA      threads do resolvedor paralelo (padrão: 1,2,4,...,nproc)\n"
+            "  --runs=R             repetições por configuração (padrão: 3)\n"
+            "  --seed=S             semente das entradas (padrão: 1)\n"
+            "  --coverage=C         cobertura do genoma sintético (padrão: 4)\n"
+            "  --solvers=LISTA      subconjunto de shsup,seq,par (padrão: todos)\n"
+            "  --par-args=ARGS      opções do resolvedor paralelo; repetível, uma\n"
+            "                       configuração por ocorrência (ex.: \"--engine=uf\")\n"
+            "  --shsup-max-n=N      maior entrada para o shsup (padrão: 100)\n"
+            "  --bin-dir=DIR        diretório dos executáveis (padrão: .)\n"
+            "  --work-dir=DIR       entradas e saídas temporárias (padrão: bench_work)\n"
+            "  --csv=ARQ            resultados em CSV (padrão: bench_work/results.csv)\n"
+            "  --json=ARQ           resultados em JSON (padrão: bench_work/results.json)\n",
+            program);
+}
+
+static bool parse_bench_options(int argc, char** argv, bench_options_t* o) {
+    parse_int_list("500,1000,2000", o->n, &o->num_n);
+    parse_int_list("50,100", o->len, &o->num_len);
+    long nproc = sysconf(_SC_NPROCESSORS_ONLN);
+    o->num_threads = 0;
+    for (int t = 1; t < nproc && o->num_threads < MAX_LIST - 1; t *= 2) o->threads[o->num_threads++] = t;
+    o->threads[o->num_threads++] = nproc > 0 ? (int)nproc : 1;
+    o->runs = 3;
+    o->seed = 1;
+    o->coverage = 4.0;
+    o->shsup_max_n = 100;
+    o->bin_dir = ".";
+    o->work_dir = "bench_work";
+    o->csv_path = NULL;
+    o->json_path = NULL;
+    o->solvers = "shsup,seq,par";
+    o->num_par_args = 0;
+
+    for (int a = 1; a < argc; ++a) {
+        const char* v = strchr(argv[a], '=');
+        v = v ? v + 1 : "";
+        bool ok = true;
+        if (strncmp(argv[a], "--n=", 4) == 0) {
+            ok = parse_int_list(v, o->n, &o->num_n);
+        } else if (strncmp(argv[a], "--len=", 6) == 0) {
+            ok = parse_int_list(v, o->len, &o->num_len);
+        } else if (strncmp(argv[a], "--threads=", 10) == 0) {
+            ok = parse_int_list(v, o->threads, &o->num_threads);
+        } else if (strncmp(argv[a], "--runs=", 7) == 0) {
+            o->runs = atoi(v);
+            ok = o->runs > 0;
+        } else if (strncmp(argv[a], "--seed=", 7) == 0) {
+            o->seed = strtoull(v, NULL, 10);
+        } else if (strncmp(argv[a], "--coverage=", 11) == 0) {
+            o->coverage = atof(v);
+            ok = o->coverage > 0;
+        } else if (strncmp(argv[a], "--solvers=", 10) == 0) {
+            o->solvers = v;
+        } else if (strncmp(argv[a], "--par-args=", 11) == 0 && o->num_par_args < MAX_SOLVERS - 2) {
+            o->par_args[o->num_par_args++] = (char*)v;
+        } else if (strncmp(argv[a], "--shsup-max-n=", 14) == 0) {
+            o->shsup_max_n = atoi(v);
+        } else if (strncmp(argv[a], "--bin-dir=", 10) == 0) {
+            o->bin_dir = v;
+        } else if (strncmp(argv[a], "--work-dir=", 11) == 0) {
+            o->work_dir = v;
+        } else if (strncmp(argv[a], "--csv=", 6) == 0) {
+            o->csv_path = v;
+        } else if (strncmp(argv[a], "--json=", 7) == 0) {
+            o->json_path = v;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            fprintf(stderr, "Opção inválida: %s\n", argv[a]);
+            print_usage(argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool solver_selected(const char* list, const char* name) {
+    size_t k = strlen(name);
+    for (const char* p = list; (p = strstr(p, name)) != NULL; p += k) {
+        bool starts = p == list || p[-1] == ',';
+        bool ends = p[k] == '\0' || p[k] == ',';
+        if (starts && ends) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Monta a lista de resolvedores; cada --par-args vira uma
+ * configuração separada do resolvedor paralelo.
+ */
+static int build_solvers(const bench_options_t* o, solver_t* solvers) {
+    int count = 0;
+    if (solver_selected(o->solvers, "shsup")) {
+        solver_t* s = &solvers[count++];
+        memset(s, 0, sizeof *s);
+        snprintf(s->label, sizeof s->label, "shsup");
+        snprintf(s->path, sizeof s->path, "%s/shsup", o->bin_dir);
+        s->small_only = true;
+    }
+    if (solver_selected(o->solvers, "seq")) {
+        solver_t* s = &solvers[count++];
+        memset(s, 0, sizeof *s);
+        snprintf(s->label, sizeof s->label, "seq");
+        snprintf(s->path, sizeof s->path, "%s/shortest_superstring", o->bin_dir);
+    }
+    if (solver_selected(o->solvers, "par")) {
+        int configs = o->num_par_args > 0 ? o->num_par_args : 1;
+        for (int c = 0; c < configs; ++c) {
+            solver_t* s = &solvers[count++];
+            memset(s, 0, sizeof *s);
+            snprintf(s->path, sizeof s->path, "%s/shortest_superstring_parallel", o->bin_dir);
+            s->threaded = true;
+            if (o->num_par_args == 0) {
+                snprintf(s->label, sizeof s->label, "par");
+                continue;
+            }
+            snprintf(s->label, sizeof s->label, "par %s", o->par_args[c]);
+            // Os argumentos são separados por espaços (sem aspas)
+            char* copy = strdup(o->par_args[c]);
+            for (char* tok = strtok(copy, " "); tok && s->num_args < MAX_ARGS; tok = strtok(NULL, " ")) {
+                s->args[s->num_args++] = tok;
+            }
+        }
+    }
+    return count;
+}
+
+int main(int argc, char** argv) {
+    bench_options_t opts;
+    if (!parse_bench_options(argc, argv, &opts)) {
+        return 1;
+    }
+
+    solver_t solvers[MAX_SOLVERS];
+    int num_solvers = build_solvers(&opts, solvers);
+    if (num_solvers == 0) {
+        fprintf(stderr, "Nenhum resolvedor selecionado.\n");
+        return 1;
+    }
+    for (int s = 0; s < num_solvers; ++s) {
+        if (access(solvers[s].path, X_OK) != 0) {
+            fprintf(stderr, "Executável não encontrado: %s (rode 'make bin')\n", solvers[s].path);
+            return 1;
+        }
+    }
+
+    if (mkdir(opts.work_dir, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "Não foi possível criar %s: %s\n", opts.work_dir, strerror(errno));
+        return 1;
+    }
+
+    char csv_default[512], json_default[512];
+    snprintf(csv_default, sizeof csv_default, "%s/results.csv", opts.work_dir);
+    snprintf(json_default, sizeof json_default, "%s/results.json", opts.work_dir);
+    const char* csv_path = opts.csv_path ? opts.csv_path : csv_default;
+    const char* json_path = opts.json_path ? opts.json_path : json_default;
+
+    FILE* csv = fopen(csv_path, "w");
+    FILE* json = fopen(json_path, "w");
+    if (csv == NULL || json == NULL) {
+        fprintf(stderr, "Não foi possível abrir os arquivos de resultado.\n");
+        return 1;
+    }
+    fprintf(csv, "solver,n,len,threads,run,wall_s,max_rss_kb,exit_code,output_ok,phases\n");
+    fprintf(json, "{\n  \"seed\": %llu,\n  \"coverage\": %g,\n  \"runs\": [",
+            (unsigned long long)opts.seed, opts.coverage);
+
+    int mismatches = 0;
+    bool first_json = true;
+    char in_path[600], ref_path[600], out_path[600], err_path[600];
+
+    for (int a = 0; a < opts.num_n; ++a) {
+        for (int b = 0; b < opts.num_len; ++b) {
+            int n = opts.n[a], len = opts.len[b];
+            snprintf(in_path, sizeof in_path, "%s/n%d_l%d.txt", opts.work_dir, n, len);
+            snprintf(ref_path, sizeof ref_path, "%s/n%d_l%d.ref", opts.work_dir, n, len);
+            snprintf(out_path, sizeof out_path, "%s/out.txt", opts.work_dir);
+            snprintf(err_path, sizeof err_path, "%s/err.txt", opts.work_dir);
+            if (!write_input(in_path, n, len, opts.coverage, opts.seed)) {
+                return 1;
+            }
+            bool have_ref = false;
+
+            for (int s = 0; s < num_solvers; ++s) {
+                const solver_t* sv = &solvers[s];
+                if (sv->small_only && n > opts.shsup_max_n) continue;
+                int num_threads = sv->threaded ? opts.num_threads : 1;
+
+                for (int t = 0; t < num_threads; ++t) {
+                    int threads = sv->threaded ? opts.threads[t] : 1;
+                    for (int run = 1; run <= opts.runs; ++run) {
+                        run_result_t r;
+                        if (!run_solver(sv, threads, in_path, out_path, err_path, &r)) {
+                            return 1;
+                        }
+
+                        bool ok = r.exit_code == 0;
+                        if (ok && !have_ref) {
+                            have_ref = copy_file(out_path, ref_path);
+                        } else if (ok) {
+                            ok = same_file(out_path, ref_path);
+                        }
+                        if (!ok) mismatches++;
+
+                        fprintf(stderr, "%-24s n=%-7d len=%-5d threads=%-3d run=%d  %9.4f s  %8ld KB%s\n",
+                                sv->label, n, len, threads, run, r.wall, r.max_rss_kb,
+                                ok ? "" : "  SAÍDA DIFERENTE");
+
+                        fprintf(csv, "\"%s\",%d,%d,%d,%d,%.6f,%ld,%d,%d,\"", sv->label, n, len,
+                                threads, run, r.wall, r.max_rss_kb, r.exit_code, ok);
+                        for (int p = 0; p < r.num_phases; ++p) {
+                            fprintf(csv, "%s%s=%.6f", p ? ";" : "", r.phases[p].name, r.phases[p].seconds);
+                        }
+                        fprintf(csv, "\"\n");
+
+                        fprintf(json, "%s\n    {\"solver\": ", first_json ? "" : ",");
+                        json_string(json, sv->label);
+                        fprintf(json, ", \"n\": %d, \"len\": %d, \"threads\": %d, \"run\": %d, "
+                                "\"wall_s\": %.6f, \"max_rss_kb\": %ld, \"exit_code\": %d, "
+                                "\"output_ok\": %s, \"phases\": {",
+                                n, len, threads, run, r.wall, r.max_rss_kb, r.exit_code,
+                                ok ? "true" : "false");
+                        for (int p = 0; p < r.num_phases; ++p) {
+                            fprintf(json, "%s", p ? ", " : "");
+                            json_string(json, r.phases[p].name);
+                            fprintf(json, ": %.6f", r.phases[p].seconds);
+                        }
+                        fprintf(json, "}}");
+                        first_json = false;
+                        fflush(csv);
+                        fflush(json);
+                    }
+                }
+            }
+        }
+    }
+
+    fprintf(json, "\n  ]\n}\n");
+    fclose(csv);
+    fclose(json);
+
+    fprintf(stderr, "Resultados: %s, %s\n", csv_path, json_path);
+    if (mismatches > 0) {
+        fprintf(stderr, "%d execução(ões) com saída diferente da referência ou com erro.\n", mismatches);
+        return 2;
+    }
+    return 0;
+}
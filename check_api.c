@@ -0,0 +1,149 @@
+/*
+ * Teste da API de shsup.h: a superstring de shsup_solve() com
+ * engine UF e min_overlap 3 deve ser idêntica à saída do executável com
+ * '--engine=uf --min-overlap=3' nas mesmas leituras; argumentos inválidos
+ * devem dar SHSUP_EINVAL com o resultado vazio, e shsup_result_free() deve
+ * deixar o resultado vazio (e poder ser chamada de novo).
+ *
+ * Ex.: ./shsup_check_api teste.txt check_out/uf.s
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "exact_superstring.h"
+#include "read_loader.h"
+#include "read_store.h"
+#include "shsup.h"
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what) {
+    if (!ok) {
+        printf("Falhou: %s\n", what);
+        failures++;
+    }
+}
+
+/**
+ * @brief Lê a saída do executável, sem as quebras de linha.
+ * @return O texto (termina em '\0'), ou NULL se o arquivo não pôde ser lido.
+ */
+static char* load_output(const char* path, size_t* len) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+        perror(path);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    rewind(f);
+    char* text = malloc(size + 1);
+    if (text == NULL) {
+        perror("Falha ao alocar memória em load_output");
+        exit(EXIT_FAILURE);
+    }
+    size_t got = fread(text, 1, size, f);
+    fclose(f);
+    size_t out = 0;
+    for (size_t k = 0; k < got; ++k) {
+        if (text[k] != '\n' && text[k] != '\r') text[out++] = text[k];
+    }
+    text[out] = '\0';
+    *len = out;
+    return text;
+}
+
+/**
+ * @brief Chama shsup_solve() com um resultado sujo e confere que ele volta
+ * vazio com o código esperado.
+ */
+static void expect_status(const char* const* reads, const size_t* lens, size_t n, const shsup_options* opts,
+                          int expected, const char* what) {
+    char dirty[] = "sujo";
+    shsup_result result = { dirty, sizeof(dirty) };
+    int status = shsup_solve(reads, lens, n, opts, &result);
+    expect(status == expected, what);
+    if (status == SHSUP_OK) {
+        shsup_result_free(&result);
+    } else {
+        expect(result.superstring == NULL && result.length == 0, what);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "Uso: %s leituras saída-do-executável\n", argv[0]);
+        return 1;
+    }
+
+    read_store_t store;
+    if (!read_loader_load(argv[1], &store, NULL)) return 1;
+    size_t expected_len;
+    char* expected = load_output(argv[2], &expected_len);
+    if (expected == NULL) {
+        read_store_free(&store);
+        return 1;
+    }
+
+    size_t n = store.count;
+    const char** reads = malloc((n + 1) * sizeof(char*));
+    size_t* lens = malloc((n + 1) * sizeof(size_t));
+    for (size_t i = 0; i < n; ++i) {
+        reads[i] = read_store_get(&store, (int)i);
+        lens[i] = store.len[i];
+    }
+
+    // --- a mesma superstring do executável ---
+    shsup_options opts;
+    shsup_options_init(&opts);
+    opts.engine = SHSUP_ENGINE_UF;
+    opts.min_overlap = 3;
+    shsup_result result;
+    int status = shsup_solve(reads, lens, n, &opts, &result);
+    expect(status == SHSUP_OK, "shsup_solve com engine UF");
+    if (status == SHSUP_OK) {
+        expect(result.length == strlen(result.superstring), "length do resultado");
+        expect(result.length == expected_len && strcmp(result.superstring, expected) == 0,
+               "superstring igual à do executável");
+        shsup_result_free(&result);
+        expect(result.superstring == NULL && result.length == 0, "shsup_result_free esvazia o resultado");
+        shsup_result_free(&result);
+    }
+
+    // --- argumentos inválidos ---
+    expect(shsup_solve(reads, lens, n, &opts, NULL) == SHSUP_EINVAL, "result NULL");
+    expect_status(NULL, lens, n, &opts, SHSUP_EINVAL, "reads NULL");
+    expect_status(reads, NULL, n, &opts, SHSUP_EINVAL, "lens NULL");
+    expect_status(NULL, NULL, 0, NULL, SHSUP_OK, "zero leituras");
+
+    shsup_options bad = opts;
+    bad.num_threads = -1;
+    expect_status(reads, lens, n, &bad, SHSUP_EINVAL, "num_threads negativo");
+    bad = opts;
+    bad.min_overlap = 0;
+    expect_status(reads, lens, n, &bad, SHSUP_EINVAL, "min_overlap zero");
+    bad = opts;
+    bad.engine = SHSUP_ENGINE_LOOP;
+    bad.seeds = 1;
+    expect_status(reads, lens, n, &bad, SHSUP_EINVAL, "seeds com o engine loop");
+    bad = opts;
+    bad.endcaps = 1;
+    expect_status(reads, lens, n, &bad, SHSUP_EINVAL, "endcaps sem filter");
+
+    shsup_options exact;
+    shsup_options_init(&exact);
+    exact.exact = 1;
+    if (n > EXACT_MAX_READS) expect_status(reads, lens, n, &exact, SHSUP_ETOOLARGE, "exact com leituras demais");
+
+    expect(strcmp(shsup_strerror(SHSUP_EINVAL), shsup_strerror(SHSUP_OK)) != 0, "shsup_strerror");
+
+    printf("%s\n", failures == 0 ? "OK" : "FALHOU");
+
+    free(reads);
+    free(lens);
+    free(expected);
+    read_store_free(&store);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+/*
+ * Teste do orçamento do armazém top-k (overlap_store.h): leituras de 300
+ * bases tiradas de um genoma a cada 2 bases, de modo que cada linha tem
+ * dezenas de candidatos com sobreposição >= 128 (varint de dois bytes), cada
+ * um num grupo próprio. O k escolhido por overlap_store_k_for_budget() deve
+ * manter o pico do armazém dentro do orçamento enquanto todas as linhas
+ * são consumidas até o fim, com recargas.
+ *
+ * Ex.: ./shsup_check_store
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overlap_store.h"
+#include "superstring.h"
+
+#define NUM_READS 400
+#define READ_LEN 300
+#define STEP 2
+#define TARGET_K 40
+
+static char* reads[NUM_READS];
+
+static int overlap_row(void* ctx, int a, int* out) {
+    (void)ctx;
+    int m = 0;
+    for (int b = 0; b < NUM_READS; ++b) {
+        if (a == b) continue;
+        int ov = calculate_overlap_simd(reads[a], READ_LEN, reads[b], READ_LEN);
+        if (ov > 0) {
+            out[2 * m] = b;
+            out[2 * m + 1] = ov;
+            m++;
+        }
+    }
+    return m;
+}
+
+static int compare_reads(const void* x, const void* y) {
+    return strcmp(reads[*(const int*)x], reads[*(const int*)y]);
+}
+
+int main(void) {
+    // Genoma pseudoaleatório fixo (gerador congruencial), para o teste ser reprodutível
+    size_t genome_len = (size_t)NUM_READS * STEP + READ_LEN;
+    char* genome = malloc(genome_len);
+    unsigned state = 12345;
+    for (size_t k = 0; k < genome_len; ++k) {
+        state = state * 1103515245u + 12345u;
+        genome[k] = "ACGT"[(state >> 16) & 3];
+    }
+    for (int i = 0; i < NUM_READS; ++i) {
+        reads[i] = malloc(READ_LEN + 1);
+        memcpy(reads[i], genome + (size_t)i * STEP, READ_LEN);
+        reads[i][READ_LEN] = '\0';
+    }
+
+    int by_rank[NUM_READS], rank[NUM_READS];
+    for (int i = 0; i < NUM_READS; ++i) by_rank[i] = i;
+    qsort(by_rank, NUM_READS, sizeof(int), compare_reads);
+    for (int r = 0; r < NUM_READS; ++r) rank[by_rank[r]] = r;
+
+    // Orçamento para cerca de TARGET_K candidatos de 5 bytes por leitura
+    size_t budget = (size_t)NUM_READS * (sizeof(store_row_t) + 16 + TARGET_K * 5);
+    int k = overlap_store_k_for_budget(budget, NUM_READS, READ_LEN);
+
+    overlap_store_t store;
+    overlap_store_init(&store, NUM_READS, k, rank, by_rank, overlap_row, NULL);
+    long long expected = 0, consumed = 0;
+    int buffer[2 * NUM_READS];
+    for (int a = 0; a < NUM_READS; ++a) {
+        expected += overlap_row(NULL, a, buffer);
+        int b, ov;
+        while (overlap_store_front(&store, a, &b, &ov)) {
+            overlap_store_pop(&store, a);
+            consumed++;
+        }
+        overlap_store_release(&store, a);
+    }
+
+    size_t used = store.peak_bytes + (size_t)NUM_READS * sizeof(store_row_t);
+    printf("k = %d, pico = %zu bytes (com os descritores %zu), orçamento = %zu, %lld recargas\n",
+           store.k, store.peak_bytes, used, budget, store.refills);
+    bool ok = k > 0 && used <= budget && consumed == expected && store.refills > 0;
+    if (consumed != expected) printf("Candidatos consumidos: %lld, esperados: %lld\n", consumed, expected);
+    printf("%s\n", ok ? "OK" : "FALHOU");
+
+    overlap_store_free(&store);
+    for (int i = 0; i < NUM_READS; ++i) free(reads[i]);
+    free(genome);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+#include "checkpoint.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Versão 2: o hash da entrada passou a incluir o comprimento de cada leitura
+static const char checkpoint_magic[8] = {'S', 'H', 'S', 'U', 'P', 'C', 'K', '2'};
+
+typedef struct {
+    char magic[8];
+    uint64_t input_hash;
+    int input_count;
+    int num_merges;
+    int count;
+    int reserved;
+} checkpoint_header_t;
+
+void merge_history_init(merge_history_t* history, char** strings, const int* lens, int count) {
+    // FNV-1a de 64 bits sobre o comprimento (4 bytes, do menos significativo
+    // ao mais) e os lens[i] bytes de cada leitura, na ordem das leituras
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (int i = 0; i < count; ++i) {
+        uint32_t len = (uint32_t)lens[i];
+        for (int b = 0; b < 4; ++b) {
+            h ^= (len >> (8 * b)) & 0xff;
+            h *= 0x100000001b3ULL;
+        }
+        const unsigned char* s = (const unsigned char*)strings[i];
+        for (int k = 0; k < lens[i]; ++k) {
+            h ^= s[k];
+            h *= 0x100000001b3ULL;
+        }
+    }
+    history->input_hash = h;
+    history->input_count = count;
+    history->merges = NULL;
+    history->num_merges = 0;
+    history->capacity = 0;
+}
+
+void merge_history_push(merge_history_t* history, int i, int j, int overlap) {
+    if (history->num_merges == history->capacity) {
+        history->capacity = history->capacity ? 2 * history->capacity : 1024;
+        history->merges = realloc(history->merges, history->capacity * sizeof(merge_record_t));
+        if (history->merges == NULL) {
+            perror("Falha ao alocar memória em merge_history_push");
+            exit(EXIT_FAILURE);
+        }
+    }
+    history->merges[history->num_merges].i = i;
+    history->merges[history->num_merges].j = j;
+    history->merges[history->num_merges].overlap = overlap;
+    history->num_merges++;
+}
+
+void merge_history_free(merge_history_t* history) {
+    free(history->merges);
+    history->merges = NULL;
+    history->num_merges = history->capacity = 0;
+}
+
+bool checkpoint_save(const char* path, const merge_history_t* history, char** strings, const int* lens, int count) {
+    size_t tmp_size = strlen(path) + 5;
+    char* tmp_path = malloc(tmp_size);
+    snprintf(tmp_path, tmp_size, "%s.tmp", path);
+
+    FILE* out = fopen(tmp_path, "wb");
+    if (out == NULL) {
+        perror(tmp_path);
+        free(tmp_path);
+        return false;
+    }
+
+    checkpoint_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, checkpoint_magic, sizeof(checkpoint_magic));
+    header.input_hash = history->input_hash;
+    header.input_count = history->input_count;
+    header.num_merges = history->num_merges;
+    header.count = count;
+
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1;
+    ok = ok && fwrite(history->merges, sizeof(merge_record_t), history->num_merges, out) == (size_t)history->num_merges;
+    ok = ok && fwrite(lens, sizeof(int), count, out) == (size_t)count;
+    for (int i = 0; i < count && ok; ++i) {
+        ok = fwrite(strings[i], 1, lens[i], out) == (size_t)lens[i];
+    }
+    ok = (fclose(out) == 0) && ok;
+    if (ok && rename(tmp_path, path) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        perror("Falha ao gravar o ponto de controle");
+        remove(tmp_path);
+    }
+    free(tmp_path);
+    return ok;
+}
+
+bool checkpoint_load(const char* path, merge_history_t* history, read_store_t* contigs) {
+    FILE* in = fopen(path, "rb");
+    if (in == NULL) {
+        perror(path);
+        return false;
+    }
+
+    checkpoint_header_t header;
+    if (fread(&header, sizeof(header), 1, in) != 1 ||
+        memcmp(header.magic, checkpoint_magic, sizeof(checkpoint_magic)) != 0 ||
+        header.count < 1 || header.num_merges < 0) {
+        fprintf(stderr, "%s: não é um ponto de controle válido\n", path);
+        fclose(in);
+        return false;
+    }
+
+    history->input_hash = header.input_hash;
+    history->input_count = header.input_count;
+    history->num_merges = header.num_merges;
+    history->capacity = header.num_merges;
+    history->merges = malloc((header.num_merges + 1) * sizeof(merge_record_t));
+    read_store_init(contigs, header.count);
+
+    int* lens = malloc(header.count * sizeof(int));
+    bool ok = history->merges != NULL && lens != NULL &&
+              fread(history->merges, sizeof(merge_record_t), header.num_merges, in) == (size_t)header.num_merges &&
+              fread(lens, sizeof(int), header.count, in) == (size_t)header.count;
+
+    // Os contigs vão direto para a arena, com um '\0' depois de cada um
+    size_t size = 0;
+    for (int i = 0; i < header.count && ok; ++i) {
+        ok = lens[i] >= 0;
+        size += (size_t)lens[i] + 1;
+    }
+    if (ok) {
+        read_store_resize(contigs, header.count, size);
+        size_t offset = 0;
+        for (int i = 0; i < header.count && ok; ++i) {
+            ok = fread(contigs->arena + offset, 1, lens[i], in) == (size_t)lens[i];
+            contigs->arena[offset + lens[i]] = '\0';
+            contigs->offset[i] = offset;
+            contigs->len[i] = lens[i];
+            offset += lens[i] + 1;
+        }
+        ok = ok && fgetc(in) == EOF;
+    }
+    free(lens);
+    fclose(in);
+
+    if (!ok) {
+        fprintf(stderr, "%s: ponto de controle truncado ou corrompido\n", path);
+        merge_history_free(history);
+        read_store_free(contigs);
+    }
+    return ok;
+}
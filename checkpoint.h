@@ -0,0 +1,76 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "read_store.h"
+
+/**
+ * @brief Uma fusão da fase gulosa: as posições de 'i' e 'j' no momento da
+ * fusão e a sobreposição usada.
+ */
+typedef struct {
+    int i;
+    int j;
+    int overlap;
+} merge_record_t;
+
+/**
+ * @brief Estado salvo junto com os contigs vivos. 'input_hash' e
+ * 'input_count' identificam as leituras (já filtradas) de que a resolução
+ * partiu, para recusar retomar sobre outra entrada.
+ */
+typedef struct {
+    uint64_t input_hash;
+    int input_count;
+    merge_record_t* merges;
+    int num_merges;
+    int capacity;
+} merge_history_t;
+
+/**
+ * @brief Inicializa um histórico vazio para as leituras dadas.
+ * * @param history O histórico.
+ * @param strings As leituras de entrada.
+ * @param lens O comprimento de cada leitura.
+ * @param count O número de leituras.
+ */
+void merge_history_init(merge_history_t* history, char** strings, const int* lens, int count);
+
+/**
+ * @brief Acrescenta uma fusão ao histórico.
+ */
+void merge_history_push(merge_history_t* history, int i, int j, int overlap);
+
+/**
+ * @brief Libera o histórico.
+ */
+void merge_history_free(merge_history_t* history);
+
+/**
+ * @brief Grava um ponto de controle binário: cabeçalho, histórico de
+ * fusões, comprimentos e bytes dos contigs vivos, em ordem. O arquivo é
+ * escrito ao lado ('<path>.tmp') e renomeado no fim, então uma interrupção
+ * durante a gravação preserva o ponto de controle anterior. Os inteiros
+ * ficam na ordem de bytes da máquina.
+ * * @param path O arquivo.
+ * @param history O histórico de fusões.
+ * @param strings Os contigs vivos.
+ * @param lens O comprimento de cada contig.
+ * @param count O número de contigs vivos.
+ * @return true em caso de sucesso; em caso de erro imprime a causa.
+ */
+bool checkpoint_save(const char* path, const merge_history_t* history, char** strings, const int* lens, int count);
+
+/**
+ * @brief Lê um ponto de controle gravado por checkpoint_save().
+ * * @param path O arquivo.
+ * @param history Recebe o histórico (liberar com merge_history_free).
+ * @param contigs Conjunto a inicializar com os contigs vivos, na ordem salva.
+ * @return true em caso de sucesso; em caso de erro imprime a causa e nada
+ * precisa ser liberado.
+ */
+bool checkpoint_load(const char* path, merge_history_t* history, read_store_t* contigs);
+
+#endif
@@ -0,0 +1,107 @@
+#include "components.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "overlap_fixed.h"
+#include "seed_index.h"
+#include "superstring.h"
+
+static void* checked_malloc(size_t size) {
+    void* p = malloc(size);
+    if (p == NULL && size > 0) {
+        perror("Falha ao alocar memória em overlap_components");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+/**
+ * @brief Raiz de 'x', com compressão por divisão ao meio feita por CAS:
+ * uma troca perdida para outra thread só deixa o caminho mais longo.
+ */
+static int find_root(int* parent, int x) {
+    for (;;) {
+        int p = __atomic_load_n(&parent[x], __ATOMIC_RELAXED);
+        if (p == x) return x;
+        int grand = __atomic_load_n(&parent[p], __ATOMIC_RELAXED);
+        if (grand != p) {
+            __atomic_compare_exchange_n(&parent[x], &p, grand, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+        }
+        x = grand;
+    }
+}
+
+/**
+ * @brief Une as componentes de 'a' e 'b', pendurando sempre a raiz maior
+ * na menor; se outra thread mexeu na raiz no meio do caminho, tenta de novo.
+ */
+static void unite(int* parent, int a, int b) {
+    for (;;) {
+        a = find_root(parent, a);
+        b = find_root(parent, b);
+        if (a == b) return;
+        int low = a < b ? a : b;
+        int high = a < b ? b : a;
+        int expected = high;
+        if (__atomic_compare_exchange_n(&parent[high], &expected, low, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            return;
+        }
+    }
+}
+
+int overlap_components(char** strings, const int* lens, int count, int min_overlap, bool seeds, int* component) {
+    int* parent = checked_malloc((count + 1) * sizeof(int));
+    for (int i = 0; i < count; ++i) parent[i] = i;
+
+    int fixed_len;
+    overlap_kernel_t overlap = overlap_fixed_select(lens, count, &fixed_len);
+    if (overlap == NULL) overlap = calculate_overlap_simd;
+
+    seed_index_t index;
+    if (seeds) {
+        seed_index_build(&index, strings, lens, count, min_overlap);
+    }
+
+    #pragma omp parallel
+    {
+        int* buffer = NULL;
+        int* seen = NULL;
+        if (seeds) {
+            buffer = checked_malloc((2 * count + 1) * sizeof(int));
+            seen = checked_malloc((count + 1) * sizeof(int));
+            for (int b = 0; b < count; ++b) seen[b] = -1;
+        }
+
+        #pragma omp for schedule(dynamic, 16)
+        for (int a = 0; a < count; ++a) {
+            if (seeds) {
+                int m = seed_index_overlaps(&index, strings, lens, a, buffer, seen);
+                for (int e = 0; e < m; ++e) unite(parent, a, buffer[2 * e]);
+                continue;
+            }
+            for (int b = 0; b < count; ++b) {
+                if (a == b || find_root(parent, a) == find_root(parent, b)) continue;
+                if (overlap(strings[a], lens[a], strings[b], lens[b]) >= min_overlap) {
+                    unite(parent, a, b);
+                }
+            }
+        }
+
+        free(buffer);
+        free(seen);
+    }
+    if (seeds) {
+        seed_index_free(&index);
+    }
+
+    // Como a raiz é sempre o menor índice, numerar as raízes em ordem
+    // crescente já dá a ordem da menor leitura de cada componente
+    int num_components = 0;
+    for (int i = 0; i < count; ++i) {
+        int root = find_root(parent, i);
+        component[i] = (root == i) ? num_components++ : component[root];
+    }
+    free(parent);
+    return num_components;
+}
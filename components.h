@@ -0,0 +1,24 @@
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Componentes conexas do grafo de sobreposição: duas leituras ficam
+ * na mesma componente se uma tem sobreposição >= min_overlap com a outra
+ * (em qualquer sentido). As arestas são encontradas em paralelo e unidas
+ * num union-find sem travas (compare-and-swap); um par já na mesma
+ * componente nem chega a ter a sobreposição calculada.
+ * * @param strings As leituras.
+ * @param lens O comprimento de cada leitura.
+ * @param count O número de leituras.
+ * @param min_overlap Menor sobreposição que liga duas leituras.
+ * @param seeds Se verdadeiro, os candidatos vêm do índice de sementes
+ * (seed_index.h) em vez da varredura de todos os pares.
+ * @param component Recebe a componente de cada leitura, numeradas a partir
+ * de 0 na ordem da menor leitura de cada uma.
+ * @return O número de componentes.
+ */
+int overlap_components(char** strings, const int* lens, int count, int min_overlap, bool seeds, int* component);
+
+#endif
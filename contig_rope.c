@@ -0,0 +1,134 @@
+#include "contig_rope.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void* checked_malloc(size_t size) {
+    void* p = malloc(size);
+    if (p == NULL && size > 0) {
+        perror("Falha ao alocar memória em contig_rope");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+void contig_rope_init(contig_rope_t* rope, int capacity, int window, string_pool_t* pool) {
+    rope->nodes = checked_malloc((capacity + 1) * sizeof(rope_node_t));
+    rope->num_nodes = 0;
+    rope->capacity = capacity;
+    rope->window = window > 0 ? window : 1;
+    rope->pool = pool;
+}
+
+int contig_rope_leaf(contig_rope_t* rope, const char* text, int len) {
+    int id = rope->num_nodes++;
+    rope_node_t* leaf = &rope->nodes[id];
+    leaf->left = -1;
+    leaf->right = -1;
+    leaf->overlap = 0;
+    leaf->len = len;
+    leaf->text = text;
+    leaf->head = text;
+    leaf->tail = text + len - contig_rope_window_len(rope, id);
+    return id;
+}
+
+int contig_rope_merge(contig_rope_t* rope, int a, int b, int overlap) {
+    int id = rope->num_nodes++;
+    const rope_node_t* x = &rope->nodes[a];
+    const rope_node_t* y = &rope->nodes[b];
+    rope_node_t* merged = &rope->nodes[id];
+    merged->left = a;
+    merged->right = b;
+    merged->overlap = overlap;
+    merged->len = x->len + y->len - overlap;
+    merged->text = NULL;
+
+    int w = contig_rope_window_len(rope, id);
+
+    // Frente: se 'a' preenche a janela ela é reaproveitada; senão 'a' está
+    // inteiro na sua janela e o resto vem da janela da frente de 'b'
+    if (x->len >= w) {
+        merged->head = x->head;
+    } else {
+        char* head = string_pool_alloc(rope->pool, w);
+        memcpy(head, x->head, x->len);
+        memcpy(head + x->len, y->head + overlap, w - x->len);
+        merged->head = head;
+    }
+
+    // Trás: o simétrico, com o fim de 'a' (antes da sobreposição) vindo da
+    // janela de trás de 'a'
+    if (y->len >= w) {
+        merged->tail = y->tail;
+    } else {
+        int from_a = w - y->len;
+        int x_window = contig_rope_window_len(rope, a);
+        char* tail = string_pool_alloc(rope->pool, w);
+        memcpy(tail, x->tail + x_window - overlap - from_a, from_a);
+        memcpy(tail + from_a, y->tail, y->len);
+        merged->tail = tail;
+    }
+    return id;
+}
+
+int contig_rope_compare(const contig_rope_t* rope, int a, int b) {
+    const rope_node_t* x = &rope->nodes[a];
+    const rope_node_t* y = &rope->nodes[b];
+    int wx = contig_rope_window_len(rope, a);
+    int wy = contig_rope_window_len(rope, b);
+    int cmp = memcmp(x->head, y->head, wx < wy ? wx : wy);
+    if (cmp != 0) return cmp;
+
+    // Se um dos contigs cabe inteiro na janela, ele é prefixo do outro
+    if (wx == x->len || wy == y->len) return (x->len > y->len) - (x->len < y->len);
+
+    char* text_x = checked_malloc(x->len);
+    char* text_y = checked_malloc(y->len);
+    contig_rope_write(rope, a, text_x);
+    contig_rope_write(rope, b, text_y);
+    cmp = memcmp(text_x, text_y, x->len < y->len ? x->len : y->len);
+    if (cmp == 0) cmp = (x->len > y->len) - (x->len < y->len);
+    free(text_x);
+    free(text_y);
+    return cmp;
+}
+
+size_t contig_rope_write(const contig_rope_t* rope, int node, char* out) {
+    // Pilha explícita: a árvore pode ter a profundidade do número de fusões.
+    // Cada entrada traz quantos caracteres do início do nó são descartados
+    // (a sobreposição com o que já foi escrito à esquerda)
+    int* stack = checked_malloc(2 * (rope->num_nodes + 1) * sizeof(int));
+    int top = 0;
+    stack[top++] = node;
+    stack[top++] = 0;
+
+    size_t written = 0;
+    int pending = 0;
+    while (top > 0) {
+        int skip = stack[--top];
+        int v = stack[--top];
+        const rope_node_t* n = &rope->nodes[v];
+        pending += skip;
+        if (n->left < 0) {
+            int drop = pending < n->len ? pending : n->len;
+            memcpy(out + written, n->text + drop, n->len - drop);
+            written += n->len - drop;
+            pending -= drop;
+        } else {
+            stack[top++] = n->right;
+            stack[top++] = n->overlap;
+            stack[top++] = n->left;
+            stack[top++] = 0;
+        }
+    }
+    free(stack);
+    return written;
+}
+
+void contig_rope_free(contig_rope_t* rope) {
+    free(rope->nodes);
+    rope->nodes = NULL;
+    rope->num_nodes = 0;
+}
@@ -0,0 +1,98 @@
+#ifndef CONTIG_ROPE_H
+#define CONTIG_ROPE_H
+
+#include <stddef.h>
+
+#include "read_store.h"
+
+/**
+ * @brief Nó da árvore de fusões. As folhas são as leituras de entrada
+ * ('left' = -1, 'text' aponta para a leitura); um nó interno é a fusão de
+ * 'left' com 'right' usando 'overlap' caracteres. Todo nó guarda as suas
+ * janelas: os primeiros e os últimos min(len, window) caracteres do contig.
+ */
+typedef struct {
+    int left;
+    int right;
+    int overlap;
+    int len;
+    const char* text;       // só nas folhas
+    const char* head;
+    const char* tail;
+} rope_node_t;
+
+/**
+ * @brief Contigs representados só pelas janelas das pontas e pela árvore
+ * de fusões, sem o texto completo.
+ *
+ * Sem leituras repetidas ou contidas em outra (read_filter.h), a maior
+ * sobreposição entre dois contigs da gulosa é menor que a maior leitura,
+ * então as janelas de 'window' = maior leitura caracteres bastam para
+ * calcular qualquer sobreposição, e uma fusão copia no máximo 2·window
+ * bytes, independentemente do tamanho dos contigs. O texto completo só é
+ * escrito no fim, por contig_rope_write().
+ */
+typedef struct {
+    rope_node_t* nodes;
+    int num_nodes;
+    int capacity;
+    int window;
+    string_pool_t* pool;    // onde as janelas das fusões são alocadas
+} contig_rope_t;
+
+/**
+ * @brief Cria uma árvore vazia.
+ * * @param rope A árvore.
+ * @param capacity Número máximo de nós (leituras + fusões).
+ * @param window Tamanho das janelas (o comprimento da maior leitura).
+ * @param pool Pool das janelas; precisa viver tanto quanto a árvore e não
+ * pode ser compactado.
+ */
+void contig_rope_init(contig_rope_t* rope, int capacity, int window, string_pool_t* pool);
+
+/**
+ * @brief Acrescenta uma leitura como folha. O texto não é copiado e deve
+ * viver tanto quanto a árvore.
+ * @return O nó da leitura.
+ */
+int contig_rope_leaf(contig_rope_t* rope, const char* text, int len);
+
+/**
+ * @brief Funde dois contigs: a janela da frente vem de 'a' (completada pela
+ * de 'b' se 'a' for curto) e a de trás de 'b'; só as janelas são copiadas.
+ * @return O nó da fusão.
+ */
+int contig_rope_merge(contig_rope_t* rope, int a, int b, int overlap);
+
+/**
+ * @brief Comprimento da janela da frente (ou de trás) de um nó.
+ */
+static inline int contig_rope_window_len(const contig_rope_t* rope, int node) {
+    int len = rope->nodes[node].len;
+    return len < rope->window ? len : rope->window;
+}
+
+/**
+ * @brief Compara dois contigs como strcmp. Quase sempre a janela da frente
+ * decide; se as duas forem iguais e os contigs maiores que elas, os textos
+ * são escritos num rascunho e comparados por inteiro.
+ */
+int contig_rope_compare(const contig_rope_t* rope, int a, int b);
+
+/**
+ * @brief Escreve o texto completo de um contig, percorrendo a árvore da
+ * esquerda para a direita e copiando cada leitura uma vez só (sem os
+ * caracteres sobrepostos). Não escreve '\0'.
+ * * @param rope A árvore.
+ * @param node O contig.
+ * @param out Destino, com espaço para o comprimento do contig.
+ * @return O número de bytes escritos.
+ */
+size_t contig_rope_write(const contig_rope_t* rope, int node, char* out);
+
+/**
+ * @brief Libera os nós (as janelas ficam no pool).
+ */
+void contig_rope_free(contig_rope_t* rope);
+
+#endif
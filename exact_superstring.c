@@ -0,0 +1,229 @@
+#include "exact_superstring.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+#include "overlap_ac.h"
+
+#define DP_NONE INT32_MIN
+
+/**
+ * @brief Tabela de coeficientes binomiais até EXACT_MAX_READS. Cada chamada
+ * de exact_superstring() preenche a sua: a biblioteca pode ser chamada por
+ * várias threads ao mesmo tempo.
+ */
+typedef long long binomial_table_t[EXACT_MAX_READS + 1][EXACT_MAX_READS + 1];
+
+static void binomial_init(binomial_table_t binomial) {
+    for (int n = 0; n <= EXACT_MAX_READS; ++n) {
+        binomial[n][0] = 1;
+        for (int k = 1; k <= n; ++k) {
+            binomial[n][k] = binomial[n - 1][k - 1] + (k < n ? binomial[n - 1][k] : 0);
+        }
+    }
+}
+
+/**
+ * @brief O r-ésimo (a partir de 0) subconjunto de k elementos em ordem
+ * numérica crescente, pelo sistema combinatório de numeração.
+ */
+static uint32_t unrank_subset(binomial_table_t binomial, long long r, int k) {
+    uint32_t mask = 0;
+    for (int i = k; i >= 1; --i) {
+        int c = i - 1;
+        while (c + 1 <= EXACT_MAX_READS && binomial[c + 1][i] <= r) c++;
+        mask |= 1u << c;
+        r -= binomial[c][i];
+    }
+    return mask;
+}
+
+/**
+ * @brief Próximo inteiro com o mesmo número de bits (truque de Gosper).
+ */
+static inline uint32_t next_subset(uint32_t v) {
+    uint32_t t = v | (v - 1);
+    return (t + 1) | (((~t & -~t) - 1) >> (__builtin_ctz(v) + 1));
+}
+
+/**
+ * @brief Índices das leituras que não estão contidas em outra; entre
+ * leituras iguais fica a de menor índice. As leituras não precisam
+ * terminar em '\0': a contenção é decidida pelo autômato de todas as
+ * leituras distintas, que só lê os 'lens[i]' bytes de cada uma.
+ */
+static int drop_contained(char** strings, const int* lens, int count, int* kept) {
+    if (count <= 0) return 0;
+    int* distinct = malloc((count + 1) * sizeof(int));
+    char** distinct_strings = malloc((count + 1) * sizeof(char*));
+    int* distinct_lens = malloc((count + 1) * sizeof(int));
+    int num_distinct = 0;
+    for (int i = 0; i < count; ++i) {
+        bool repeated = false;
+        for (int j = 0; j < i && !repeated; ++j) {
+            repeated = lens[j] == lens[i] && memcmp(strings[i], strings[j], lens[i]) == 0;
+        }
+        if (repeated) continue;
+        distinct[num_distinct] = i;
+        distinct_strings[num_distinct] = strings[i];
+        distinct_lens[num_distinct] = lens[i];
+        num_distinct++;
+    }
+
+    bool* contained = contained_strings_ac(distinct_strings, distinct_lens, num_distinct, false);
+    int m = 0;
+    for (int d = 0; d < num_distinct; ++d) {
+        // O autômato ignora a leitura vazia, que está contida em qualquer outra
+        if (contained[d] || (distinct_lens[d] == 0 && num_distinct > 1)) continue;
+        kept[m++] = distinct[d];
+    }
+
+    free(contained);
+    free(distinct_lens);
+    free(distinct_strings);
+    free(distinct);
+    return m;
+}
+
+char* exact_superstring(char** strings, const int* lens, int count, int greedy_len) {
+    int* kept = malloc(count * sizeof(int));
+    int m = drop_contained(strings, lens, count, kept);
+    if (m > EXACT_MAX_READS) {
+        fprintf(stderr, "Modo exato: %d leituras restantes (máximo %d).\n", m, EXACT_MAX_READS);
+        free(kept);
+        return NULL;
+    }
+
+    char** reads = malloc(m * sizeof(char*));
+    int* read_lens = malloc(m * sizeof(int));
+    long long total_len = 0;
+    for (int i = 0; i < m; ++i) {
+        reads[i] = strings[kept[i]];
+        read_lens[i] = lens[kept[i]];
+        total_len += read_lens[i];
+    }
+    free(kept);
+
+    // Sem leituras contidas, toda sobreposição é menor que as duas strings
+    int* ov = overlap_matrix_ac(reads, read_lens, m, false);
+
+    // Limite superior do que ainda pode ser ganho: cada leitura fora de S
+    // entra por uma aresta de no máximo max_in[j]
+    int max_in[EXACT_MAX_READS];
+    int max_in_total = 0;
+    for (int j = 0; j < m; ++j) {
+        max_in[j] = 0;
+        for (int i = 0; i < m; ++i) {
+            if (i != j && ov[i * m + j] > max_in[j]) max_in[j] = ov[i * m + j];
+        }
+        max_in_total += max_in[j];
+    }
+    long long lower_bound = greedy_len > 0 ? total_len - greedy_len : 0;
+
+    // dp[S * m + j]: as m entradas de um subconjunto ficam contíguas, e a
+    // leitura de dp[S \ {j}][*] na transição percorre uma linha inteira
+    size_t states = (size_t)1 << m;
+    int32_t* dp = malloc(states * m * sizeof(int32_t));
+    if (dp == NULL) {
+        fprintf(stderr, "Modo exato: memória insuficiente para 2^%d estados.\n", m);
+        free(ov);
+        free(reads);
+        free(read_lens);
+        return NULL;
+    }
+    binomial_table_t binomial;
+    binomial_init(binomial);
+
+    #pragma omp parallel for schedule(static)
+    for (size_t s = 0; s < states; ++s) {
+        for (int j = 0; j < m; ++j) dp[s * m + j] = DP_NONE;
+    }
+    for (int j = 0; j < m; ++j) dp[((size_t)1 << j) * m + j] = 0;
+
+    for (int k = 2; k <= m; ++k) {
+        long long layer = binomial[m][k];
+        long long num_chunks = (long long)omp_get_max_threads() * 16;
+        if (num_chunks > layer) num_chunks = layer;
+
+        // Cada bloco de posições da camada começa pelo seu primeiro
+        // subconjunto e segue com o truque de Gosper
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (long long c = 0; c < num_chunks; ++c) {
+            long long first = layer * c / num_chunks;
+            long long last = layer * (c + 1) / num_chunks;
+            uint32_t s = unrank_subset(binomial, first, k);
+
+            for (long long r = first; r < last; ++r, s = next_subset(s)) {
+                int remaining = max_in_total;
+                for (uint32_t bits = s; bits; bits &= bits - 1) remaining -= max_in[__builtin_ctz(bits)];
+
+                for (uint32_t bits = s; bits; bits &= bits - 1) {
+                    int j = __builtin_ctz(bits);
+                    const int32_t* prev = dp + (size_t)(s ^ (1u << j)) * m;
+                    int32_t best = DP_NONE;
+                    for (uint32_t from = s ^ (1u << j); from; from &= from - 1) {
+                        int i = __builtin_ctz(from);
+                        if (prev[i] == DP_NONE) continue;
+                        int32_t value = prev[i] + ov[i * m + j];
+                        if (value > best) best = value;
+                    }
+                    // Poda: nem ganhando o máximo no resto supera a gulosa
+                    if (best != DP_NONE && best + remaining < lower_bound) best = DP_NONE;
+                    dp[(size_t)s * m + j] = best;
+                }
+            }
+        }
+    }
+
+    // Reconstrói a ordem de trás para frente
+    uint32_t full = (uint32_t)(states - 1);
+    int end = 0;
+    for (int j = 1; j < m; ++j) {
+        if (dp[(size_t)full * m + j] > dp[(size_t)full * m + end]) end = j;
+    }
+    int32_t best_total = dp[(size_t)full * m + end];
+    if (best_total == DP_NONE) {
+        fprintf(stderr, "Modo exato: o limite guloso (%d) é menor que o ótimo.\n", greedy_len);
+        free(dp);
+        free(ov);
+        free(reads);
+        free(read_lens);
+        return NULL;
+    }
+
+    int* order = malloc(m * sizeof(int));
+    uint32_t s = full;
+    for (int pos = m - 1, j = end; pos >= 0; --pos) {
+        order[pos] = j;
+        uint32_t rest = s ^ (1u << j);
+        int32_t value = dp[(size_t)s * m + j];
+        int next = -1;
+        for (uint32_t from = rest; from && next < 0; from &= from - 1) {
+            int i = __builtin_ctz(from);
+            if (dp[(size_t)rest * m + i] != DP_NONE && dp[(size_t)rest * m + i] + ov[i * m + j] == value) next = i;
+        }
+        s = rest;
+        j = next;
+    }
+
+    char* result = malloc(total_len - best_total + 1);
+    int pos = 0;
+    for (int k = 0; k < m; ++k) {
+        int j = order[k];
+        int skip = k > 0 ? ov[order[k - 1] * m + j] : 0;
+        memcpy(result + pos, reads[j] + skip, read_lens[j] - skip);
+        pos += read_lens[j] - skip;
+    }
+    result[pos] = '\0';
+
+    free(order);
+    free(dp);
+    free(ov);
+    free(reads);
+    free(read_lens);
+    return result;
+}
@@ -0,0 +1,28 @@
+#ifndef EXACT_SUPERSTRING_H
+#define EXACT_SUPERSTRING_H
+
+/**
+ * @brief Maior número de leituras (depois de remover as contidas) aceito
+ * pelo modo exato: a tabela tem 2^m × m inteiros.
+ */
+#define EXACT_MAX_READS 24
+
+/**
+ * @brief Calcula a menor superstring exata com a programação dinâmica de
+ * Held–Karp sobre a matriz de sobreposições (formulação de caixeiro
+ * viajante): dp[S][j] é a maior sobreposição total de uma ordem das
+ * leituras de S que termina em j. Leituras repetidas ou contidas em outra
+ * são removidas antes. Cada camada de subconjuntos com o mesmo número de
+ * elementos é processada em paralelo, e estados que não podem superar a
+ * solução gulosa são podados.
+ * * @param strings As leituras.
+ * @param lens O comprimento de cada leitura.
+ * @param count O número de leituras.
+ * @param greedy_len Comprimento de uma superstring conhecida (por exemplo a
+ * gulosa), usado como limite para a poda; 0 desativa a poda.
+ * @return A superstring ótima, ou NULL se restarem mais de EXACT_MAX_READS
+ * leituras ou faltar memória. O chamador deve liberá-la.
+ */
+char* exact_superstring(char** strings, const int* lens, int count, int greedy_len);
+
+#endif
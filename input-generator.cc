@@ -1,9 +1,17 @@
 #include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <random>
 #include <set>
 #include <string>
 
 using String = std::string ;
+using Size   = std::size_t ;
+using Random = std::mt19937_64 ;
 
 template<typename T>
 using Set = std::set <T> ;
@@ -41,8 +49,186 @@ write_strings (const Set <String>& ss) -> void
     }
 }
 
+// Modo de amostragem: leituras tiradas de um genoma de referência
+// (lido de um arquivo FASTA/texto ou aleatório), escritas uma a uma
+// sem guardar o conjunto em memória.
+
+enum class Format { counted, fasta, fastq } ;
+
+struct SamplingOptions
+{
+    String    reference ;           // vazio = genoma aleatório
+    Size      genome_length = 100000 ;
+    Size      read_length   = 100 ;
+    double    coverage      = 10.0 ;
+    double    error_rate    = 0.0 ;
+    uint64_t  seed          = 1 ;
+    Format    format        = Format::counted ;
+} ;
+
+inline auto
+starts_with (const char* s, const char* prefix) -> bool
+{
+    return std::strncmp (s, prefix, std::strlen (prefix)) == 0 ;
+}
+
+inline auto
+value_of (const char* arg) -> const char*
+{
+    return std::strchr (arg, '=') + 1 ;
+}
+
+auto
+write_usage (const char* program) -> void
+{
+    std::cerr
+        << "Uso: " << program << " < string           (todas as permutações)\n"
+        << "     " << program << " --sample [opções]  (leituras de um genoma)\n"
+        << "  --reference=ARQ   genoma em FASTA ou texto (padrão: aleatório)\n"
+        << "  --genome=G        tamanho do genoma aleatório (padrão: 100000)\n"
+        << "  --length=L        comprimento das leituras (padrão: 100)\n"
+        << "  --coverage=C      cobertura média (padrão: 10)\n"
+        << "  --error-rate=E    probabilidade de substituição por base (padrão: 0)\n"
+        << "  --seed=S          semente (padrão: 1)\n"
+        << "  --format=F        counted, fasta ou fastq (padrão: counted)\n" ;
+}
+
+auto
+parse_sampling_options (int argc, char const* argv[], SamplingOptions& o) -> bool
+{
+    for (int a = 1 ; a < argc ; ++ a) {
+        const char* arg = argv [a] ;
+        if (std::strcmp (arg, "--sample") == 0) {
+            continue ;
+        } else if (starts_with (arg, "--reference=")) {
+            o.reference = value_of (arg) ;
+        } else if (starts_with (arg, "--genome=")) {
+            o.genome_length = std::strtoull (value_of (arg), nullptr, 10) ;
+        } else if (starts_with (arg, "--length=")) {
+            o.read_length = std::strtoull (value_of (arg), nullptr, 10) ;
+        } else if (starts_with (arg, "--coverage=")) {
+            o.coverage = std::atof (value_of (arg)) ;
+        } else if (starts_with (arg, "--error-rate=")) {
+            o.error_rate = std::atof (value_of (arg)) ;
+        } else if (starts_with (arg, "--seed=")) {
+            o.seed = std::strtoull (value_of (arg), nullptr, 10) ;
+        } else if (std::strcmp (arg, "--format=counted") == 0) {
+            o.format = Format::counted ;
+        } else if (std::strcmp (arg, "--format=fasta") == 0) {
+            o.format = Format::fasta ;
+        } else if (std::strcmp (arg, "--format=fastq") == 0) {
+            o.format = Format::fastq ;
+        } else {
+            std::cerr << "Opção desconhecida: " << arg << std::endl ;
+            return false ;
+        }
+    }
+    return o.read_length > 0
+        && o.coverage > 0
+        && o.error_rate >= 0 && o.error_rate <= 1 ;
+}
+
+auto
+read_reference (const String& path, String& genome) -> bool
+{
+    std::ifstream in (path) ;
+    if (! in) return false ;
+    String line ;
+    while (std::getline (in, line)) {
+        if (! line.empty () && (line [0] == '>' || line [0] == ';')) continue ;
+        for (char c : line) {
+            if (! std::isspace (static_cast <unsigned char> (c))) {
+                genome.push_back (std::toupper (static_cast <unsigned char> (c))) ;
+            }
+        }
+    }
+    return true ;
+}
+
+auto
+random_genome (Size length, Random& rng) -> String
+{
+    static const char bases [] = "ACGT" ;
+    String g (length, 'A') ;
+    for (char& c : g) c = bases [rng () >> 62] ;
+    return g ;
+}
+
+// Troca a base por uma das outras três
+inline auto
+substitute (char c, Random& rng) -> char
+{
+    static const char bases [] = "ACGT" ;
+    char x ;
+    do {
+        x = bases [rng () >> 62] ;
+    } while (x == c) ;
+    return x ;
+}
+
+auto
+write_sampled_reads (const SamplingOptions& o) -> int
+{
+    Random rng (o.seed) ;
+
+    String genome ;
+    if (o.reference.empty ()) {
+        genome = random_genome (o.genome_length, rng) ;
+    } else if (! read_reference (o.reference, genome)) {
+        std::cerr << "Não foi possível ler " << o.reference << std::endl ;
+        return 1 ;
+    }
+    if (genome.size () < o.read_length) {
+        std::cerr << "O genoma é menor que o comprimento das leituras." << std::endl ;
+        return 1 ;
+    }
+
+    Size n = std::max <Size>
+        (1, Size (o.coverage * genome.size () / o.read_length + 0.5)) ;
+    std::uniform_int_distribution <Size> position (0, genome.size () - o.read_length) ;
+    std::bernoulli_distribution error (o.error_rate) ;
+
+    std::ios::sync_with_stdio (false) ;
+    if (o.format == Format::counted) {
+        std::cout << n << '\n' ;
+    }
+
+    String read (o.read_length, 'A') ;
+    String quality (o.read_length, 'I') ;
+    for (Size i = 0 ; i < n ; ++ i) {
+        Size p = position (rng) ;
+        for (Size k = 0 ; k < o.read_length ; ++ k) {
+            read [k] = genome [p + k] ;
+            if (o.error_rate > 0 && error (rng)) read [k] = substitute (read [k], rng) ;
+        }
+        switch (o.format) {
+            case Format::counted :
+                std::cout << read << '\n' ;
+                break ;
+            case Format::fasta :
+                std::cout << ">r" << i << " pos=" << p << '\n' << read << '\n' ;
+                break ;
+            case Format::fastq :
+                std::cout << "@r" << i << " pos=" << p << '\n' << read << "\n+\n" << quality << '\n' ;
+                break ;
+        }
+    }
+    std::cout.flush () ;
+    return 0 ;
+}
+
 int main (int argc, char const* argv[])
 {
+    if (argc > 1) {
+        SamplingOptions o ;
+        if (std::strcmp (argv [1], "--sample") != 0
+                || ! parse_sampling_options (argc, argv, o)) {
+            write_usage (argv [0]) ;
+            return 1 ;
+        }
+        return write_sampled_reads (o) ;
+    }
+
     // s = 720 for the contest
     String s = read_string_from_standard_input () ;
     Set <String> ss = all_permutations (s) ;
@@ -50,4 +236,3 @@ int main (int argc, char const* argv[])
     write_strings (ss) ;
     return 0 ;
 }
-
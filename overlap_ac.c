@@ -0,0 +1,395 @@
+#include "overlap_ac.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+/**
+ * @brief Autômato de Aho-Corasick sobre todas as strings.
+ * Cada nó da trie representa um prefixo de alguma string; como as strings
+ * são inseridas em ordem lexicográfica, as strings que têm esse prefixo
+ * formam o intervalo contíguo [lo, hi) dessa ordem.
+ */
+typedef struct {
+    int sigma;          // tamanho do alfabeto efetivo
+    int num_nodes;
+    int* delta;         // função de transição completa, num_nodes × sigma
+    int* fail;          // link de falha
+    int* depth;         // comprimento do prefixo representado pelo nó
+    int* lo;
+    int* hi;
+    unsigned char symbol[256];  // byte -> símbolo compacto
+    bool present[256];          // o byte aparece em alguma string; os demais voltam à raiz
+} ac_automaton_t;
+
+// Uma cópia por thread: o modo lote resolve várias instâncias ao mesmo tempo
+static const char** sort_strings;
+static const int* sort_lens;
+#pragma omp threadprivate(sort_strings, sort_lens)
+
+// Ordem de strcmp, mas pelos comprimentos: as leituras não precisam terminar em '\0'
+static int compare_by_string(const void* x, const void* y) {
+    int i = *(const int*)x;
+    int j = *(const int*)y;
+    int len = sort_lens[i] < sort_lens[j] ? sort_lens[i] : sort_lens[j];
+    int cmp = memcmp(sort_strings[i], sort_strings[j], len);
+    if (cmp != 0) return cmp;
+    if (sort_lens[i] != sort_lens[j]) return sort_lens[i] < sort_lens[j] ? -1 : 1;
+    return (i > j) - (i < j);
+}
+
+static void* checked_malloc(size_t size) {
+    void* p = malloc(size);
+    if (p == NULL) {
+        perror("Falha ao alocar memória em overlap_matrix_ac");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+/**
+ * @brief Constrói o autômato inserindo as strings na ordem de 'by_rank'.
+ */
+static void ac_build(ac_automaton_t* ac, char** strings, const int* lens, const int* by_rank, int count) {
+    bool* present = ac->present;
+    memset(present, 0, sizeof(ac->present));
+    size_t total = 0;
+    for (int i = 0; i < count; ++i) {
+        const unsigned char* s = (const unsigned char*)strings[i];
+        for (int k = 0; k < lens[i]; ++k) present[s[k]] = true;
+        total += lens[i];
+    }
+    ac->sigma = 0;
+    for (int c = 0; c < 256; ++c) {
+        ac->symbol[c] = present[c] ? ac->sigma++ : 0;
+    }
+    if (ac->sigma == 0) ac->sigma = 1;
+
+    size_t max_nodes = total + 1;
+    ac->delta = checked_malloc(max_nodes * ac->sigma * sizeof(int));
+    ac->fail = checked_malloc(max_nodes * sizeof(int));
+    ac->depth = checked_malloc(max_nodes * sizeof(int));
+    ac->lo = checked_malloc(max_nodes * sizeof(int));
+    ac->hi = checked_malloc(max_nodes * sizeof(int));
+
+    // Trie: -1 marca transição ainda inexistente
+    memset(ac->delta, -1, ac->sigma * sizeof(int));
+    ac->depth[0] = 0;
+    ac->lo[0] = 0;
+    ac->hi[0] = count;
+    ac->num_nodes = 1;
+
+    for (int r = 0; r < count; ++r) {
+        int v = 0;
+        const unsigned char* s = (const unsigned char*)strings[by_rank[r]];
+        for (int k = 0; k < lens[by_rank[r]]; ++k) {
+            int c = ac->symbol[s[k]];
+            int u = ac->delta[v * ac->sigma + c];
+            if (u == -1) {
+                u = ac->num_nodes++;
+                memset(ac->delta + (size_t)u * ac->sigma, -1, ac->sigma * sizeof(int));
+                ac->depth[u] = ac->depth[v] + 1;
+                ac->lo[u] = r;
+                ac->delta[v * ac->sigma + c] = u;
+            }
+            ac->hi[u] = r + 1;
+            v = u;
+        }
+    }
+
+    // Links de falha e transições completas em ordem de largura
+    int* queue = checked_malloc(ac->num_nodes * sizeof(int));
+    int head = 0, tail = 0;
+    ac->fail[0] = 0;
+    for (int c = 0; c < ac->sigma; ++c) {
+        int u = ac->delta[c];
+        if (u == -1) {
+            ac->delta[c] = 0;
+        } else {
+            ac->fail[u] = 0;
+            queue[tail++] = u;
+        }
+    }
+    while (head < tail) {
+        int v = queue[head++];
+        for (int c = 0; c < ac->sigma; ++c) {
+            size_t idx = (size_t)v * ac->sigma + c;
+            int u = ac->delta[idx];
+            int via_fail = ac->delta[(size_t)ac->fail[v] * ac->sigma + c];
+            if (u == -1) {
+                ac->delta[idx] = via_fail;
+            } else {
+                ac->fail[u] = via_fail;
+                queue[tail++] = u;
+            }
+        }
+    }
+    free(queue);
+}
+
+static void ac_free(ac_automaton_t* ac) {
+    free(ac->delta);
+    free(ac->fail);
+    free(ac->depth);
+    free(ac->lo);
+    free(ac->hi);
+}
+
+/**
+ * @brief Próximo índice ainda não atribuído a partir de 'x' (union-find com
+ * compressão de caminho sobre as posições de uma linha).
+ */
+static int next_free(int* skip, int x) {
+    int root = x;
+    while (skip[root] != root) root = skip[root];
+    while (skip[x] != root) {
+        int up = skip[x];
+        skip[x] = root;
+        x = up;
+    }
+    return root;
+}
+
+int* overlap_matrix_ac(char** strings, const int* lens, int count, bool parallel) {
+    int* matrix = NULL;
+
+    #pragma omp parallel if(parallel)
+    {
+        int* team_matrix = overlap_matrix_ac_team(strings, lens, strings, lens, count, 0, count);
+        #pragma omp master
+        matrix = team_matrix;
+    }
+    return matrix;
+}
+
+int* overlap_matrix_ac_team(char** strings, const int* lens, char** prefixes, const int* prefix_lens,
+                            int count, int row_begin, int row_end) {
+    int* matrix;
+    int* by_rank;
+    ac_automaton_t ac;
+
+    #pragma omp single copyprivate(matrix, by_rank, ac)
+    {
+        matrix = checked_malloc((size_t)(row_end - row_begin) * count * sizeof(int) + 1);
+        by_rank = checked_malloc((count + 1) * sizeof(int));
+        for (int i = 0; i < count; ++i) by_rank[i] = i;
+        sort_strings = (const char**)prefixes;
+        sort_lens = prefix_lens;
+        qsort(by_rank, count, sizeof(int), compare_by_string);
+        ac_build(&ac, prefixes, prefix_lens, by_rank, count);
+    }
+
+    {
+        int* skip = checked_malloc((count + 1) * sizeof(int));
+
+        #pragma omp for schedule(dynamic, 16)
+        for (int i = row_begin; i < row_end; ++i) {
+            int* row = matrix + (size_t)(i - row_begin) * count;
+            for (int x = 0; x <= count; ++x) skip[x] = x;
+
+            // Estado final = maior sufixo de strings[i] que é prefixo de alguma string
+            int v = 0;
+            const unsigned char* s = (const unsigned char*)strings[i];
+            // As linhas podem ter bytes que nenhum prefixo tem (as janelas de
+            // cauda do modo endcaps): nenhum sufixo que os contenha é prefixo
+            for (int k = 0; k < lens[i]; ++k) {
+                v = ac.present[s[k]] ? ac.delta[(size_t)v * ac.sigma + ac.symbol[s[k]]] : 0;
+            }
+
+            // Percorre os sufixos do mais longo para o mais curto; cada string
+            // recebe a profundidade do primeiro nó cujo intervalo a contém.
+            for (; v != 0; v = ac.fail[v]) {
+                for (int x = next_free(skip, ac.lo[v]); x < ac.hi[v]; x = next_free(skip, x + 1)) {
+                    row[by_rank[x]] = ac.depth[v];
+                    skip[x] = x + 1;
+                }
+            }
+            for (int x = next_free(skip, 0); x < count; x = next_free(skip, x + 1)) {
+                row[by_rank[x]] = 0;
+                skip[x] = x + 1;
+            }
+            row[i] = 0;
+        }
+
+        free(skip);
+    }
+
+    #pragma omp single
+    {
+        ac_free(&ac);
+        free(by_rank);
+    }
+    return matrix;
+}
+
+/**
+ * @brief Nós terminais e links de saída do autômato das strings.
+ * * @param ac O autômato.
+ * @param strings As strings (inseridas em 'ac').
+ * @param lens O comprimento de cada string.
+ * @param count O número de strings.
+ * @param terminal Recebe, para cada nó, uma string que termina nele (-1 se nenhuma).
+ * @param end_node Recebe o nó em que cada string termina.
+ * @param by_depth Se não for NULL, recebe os nós em ordem de profundidade.
+ * @return output[v]: nó terminal mais profundo na cadeia de falhas de v (ele
+ * mesmo incluído), 0 se nenhum. Todos os vetores devem ser liberados.
+ */
+static int* ac_output_links(const ac_automaton_t* ac, char** strings, const int* lens, int count,
+                            int** terminal, int** end_node, int** by_depth) {
+    *terminal = checked_malloc(ac->num_nodes * sizeof(int));
+    memset(*terminal, -1, ac->num_nodes * sizeof(int));
+    *end_node = checked_malloc((count + 1) * sizeof(int));
+    for (int i = 0; i < count; ++i) {
+        int v = 0;
+        const unsigned char* s = (const unsigned char*)strings[i];
+        for (int k = 0; k < lens[i]; ++k) v = ac->delta[(size_t)v * ac->sigma + ac->symbol[s[k]]];
+        (*terminal)[v] = i;
+        (*end_node)[i] = v;
+    }
+
+    // Os nós são visitados em ordem de profundidade, para que
+    // output[fail[v]] já esteja pronto
+    int max_depth = 0;
+    for (int v = 0; v < ac->num_nodes; ++v) {
+        if (ac->depth[v] > max_depth) max_depth = ac->depth[v];
+    }
+    int* start = calloc(max_depth + 2, sizeof(int));
+    int* order = checked_malloc(ac->num_nodes * sizeof(int));
+    for (int v = 0; v < ac->num_nodes; ++v) start[ac->depth[v] + 1]++;
+    for (int d = 0; d <= max_depth; ++d) start[d + 1] += start[d];
+    for (int v = 0; v < ac->num_nodes; ++v) order[start[ac->depth[v]]++] = v;
+    free(start);
+
+    int* output = checked_malloc(ac->num_nodes * sizeof(int));
+    output[0] = 0;
+    for (int x = 1; x < ac->num_nodes; ++x) {
+        int v = order[x];
+        output[v] = (*terminal)[v] >= 0 ? v : output[ac->fail[v]];
+    }
+    if (by_depth != NULL) {
+        *by_depth = order;
+    } else {
+        free(order);
+    }
+    return output;
+}
+
+bool* contained_strings_ac(char** strings, const int* lens, int count, bool parallel) {
+    bool* contained = calloc(count + 1, sizeof(bool));
+    if (contained == NULL) {
+        perror("Falha ao alocar memória em contained_strings_ac");
+        exit(EXIT_FAILURE);
+    }
+    if (count < 2) return contained;
+
+    int* order = checked_malloc(count * sizeof(int));
+    for (int i = 0; i < count; ++i) order[i] = i;
+    ac_automaton_t ac;
+    ac_build(&ac, strings, lens, order, count);
+    free(order);
+
+    int* terminal;
+    int* end_node;
+    int* output = ac_output_links(&ac, strings, lens, count, &terminal, &end_node, NULL);
+
+    // Em cada posição basta marcar o padrão mais longo que termina ali: os
+    // mais curtos são sufixos dele e serão marcados quando ele for percorrido
+    #pragma omp parallel for schedule(dynamic, 64) if(parallel)
+    for (int i = 0; i < count; ++i) {
+        int v = 0;
+        const unsigned char* s = (const unsigned char*)strings[i];
+        for (int k = 0; k < lens[i]; ++k) {
+            v = ac.delta[(size_t)v * ac.sigma + ac.symbol[s[k]]];
+            int p = output[v];
+            if (p == end_node[i]) p = output[ac.fail[p]];
+            if (p != 0) {
+                #pragma omp atomic write
+                contained[terminal[p]] = true;
+            }
+        }
+    }
+
+    free(output);
+    free(end_node);
+    free(terminal);
+    ac_free(&ac);
+    return contained;
+}
+
+bool* strings_in_text_ac(char** strings, const int* lens, int count, const char* text, size_t text_len,
+                         bool parallel) {
+    bool* found = calloc(count + 1, sizeof(bool));
+    if (found == NULL) {
+        perror("Falha ao alocar memória em strings_in_text_ac");
+        exit(EXIT_FAILURE);
+    }
+    if (count <= 0) return found;
+
+    int* order = checked_malloc(count * sizeof(int));
+    for (int i = 0; i < count; ++i) order[i] = i;
+    ac_automaton_t ac;
+    ac_build(&ac, strings, lens, order, count);
+    free(order);
+
+    int* terminal;
+    int* end_node;
+    int* by_depth;
+    int* output = ac_output_links(&ac, strings, lens, count, &terminal, &end_node, &by_depth);
+
+    int max_len = 0;
+    for (int i = 0; i < count; ++i) {
+        if (lens[i] > max_len) max_len = lens[i];
+    }
+
+    // Cada thread percorre um pedaço contíguo do texto, começando
+    // max_len - 1 bytes antes dele para achar as ocorrências que cruzam a
+    // fronteira; só marca as que terminam dentro do seu pedaço. Como no
+    // caso das contidas, basta marcar o nó terminal mais longo de cada
+    // posição: os mais curtos são propagados depois, pela cadeia de saídas
+    bool* hit = calloc(ac.num_nodes, sizeof(bool));
+    #pragma omp parallel if(parallel)
+    {
+        int threads = omp_get_num_threads();
+        int t = omp_get_thread_num();
+        size_t begin = text_len * t / threads;
+        size_t end = text_len * (t + 1) / threads;
+        size_t warmup = begin > (size_t)(max_len - 1) ? begin - (max_len - 1) : 0;
+
+        int v = 0;
+        const unsigned char* s = (const unsigned char*)text;
+        for (size_t k = warmup; k < end; ++k) {
+            // Bytes do texto fora do alfabeto das strings voltam à raiz
+            if (!ac.present[s[k]]) {
+                v = 0;
+                continue;
+            }
+            v = ac.delta[(size_t)v * ac.sigma + ac.symbol[s[k]]];
+            int p = output[v];
+            if (p == 0 || k < begin) continue;
+            bool seen;
+            #pragma omp atomic read
+            seen = hit[p];
+            if (!seen) {
+                #pragma omp atomic write
+                hit[p] = true;
+            }
+        }
+    }
+
+    // Dos nós mais profundos para os mais rasos: um terminal encontrado
+    // implica o terminal seguinte da sua cadeia de saídas
+    for (int x = ac.num_nodes - 1; x > 0; --x) {
+        int v = by_depth[x];
+        if (hit[v]) hit[output[ac.fail[v]]] = true;
+    }
+    for (int i = 0; i < count; ++i) found[i] = hit[end_node[i]] || lens[i] == 0;
+
+    free(hit);
+    free(by_depth);
+    free(output);
+    free(end_node);
+    free(terminal);
+    ac_free(&ac);
+    return found;
+}
@@ -0,0 +1,64 @@
+#ifndef OVERLAP_AC_H
+#define OVERLAP_AC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Calcula a maior sobreposição sufixo-prefixo de todos os pares
+ * ordenados de strings com um único autômato de Aho-Corasick (abordagem
+ * all-pairs suffix-prefix de Gusfield), em O(comprimento total + n²).
+ * * @param strings As strings.
+ * @param lens O comprimento de cada string.
+ * @param count O número de strings.
+ * @param parallel Se verdadeiro, as linhas da matriz são calculadas em paralelo.
+ * @return Matriz count×count em ordem de linhas: o elemento [i * count + j] é o
+ * comprimento do maior sufixo de strings[i] que é prefixo de strings[j]
+ * (a diagonal é zero). O chamador deve liberá-la.
+ */
+int* overlap_matrix_ac(char** strings, const int* lens, int count, bool parallel);
+
+/**
+ * @brief Igual a overlap_matrix_ac(), mas deve ser chamada por todas as
+ * threads de uma região paralela já aberta: o trabalho é dividido com
+ * construções órfãs (single/for) entre as threads do time atual. Fora de
+ * uma região paralela roda sequencialmente. Só as linhas
+ * [row_begin, row_end) são calculadas. Os sufixos vêm de 'strings' e os
+ * prefixos de 'prefixes', que podem ser outras strings (as janelas das
+ * pontas de contig_rope.h) ou as mesmas.
+ * @return A mesma matriz (row_end - row_begin)×count para todas as threads;
+ * a linha i fica em [(i - row_begin) * count].
+ */
+int* overlap_matrix_ac_team(char** strings, const int* lens, char** prefixes, const int* prefix_lens,
+                            int count, int row_begin, int row_end);
+
+/**
+ * @brief Marca as strings que aparecem dentro de outra, percorrendo cada
+ * string uma vez no autômato de Aho-Corasick de todas elas e seguindo os
+ * links de saída (nó terminal mais próximo na cadeia de falhas).
+ * As strings devem ser distintas; strings vazias são ignoradas.
+ * * @param strings As strings.
+ * @param lens O comprimento de cada string.
+ * @param count O número de strings.
+ * @param parallel Se verdadeiro, as strings são percorridas em paralelo.
+ * @return Vetor de 'count' flags (true = contida em outra). O chamador deve liberá-lo.
+ */
+bool* contained_strings_ac(char** strings, const int* lens, int count, bool parallel);
+
+/**
+ * @brief Marca as strings que aparecem em 'text' com uma única passada do
+ * autômato de todas elas. O texto é dividido em pedaços percorridos em
+ * paralelo; cada pedaço começa (maior string - 1) bytes antes, para achar as
+ * ocorrências que cruzam a fronteira.
+ * * @param strings As strings procuradas (podem se repetir).
+ * @param lens O comprimento de cada string.
+ * @param count O número de strings.
+ * @param text O texto.
+ * @param text_len O comprimento do texto.
+ * @param parallel Se verdadeiro, os pedaços são percorridos em paralelo.
+ * @return Vetor de 'count' flags (true = aparece no texto). O chamador deve liberá-lo.
+ */
+bool* strings_in_text_ac(char** strings, const int* lens, int count, const char* text, size_t text_len,
+                         bool parallel);
+
+#endif
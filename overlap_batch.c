@@ -0,0 +1,232 @@
+#include "overlap_batch.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_DISPATCH 1
+#endif
+
+typedef enum {
+    ISA_GENERIC,
+    ISA_AVX2,
+    ISA_AVX512
+} batch_isa_t;
+
+static batch_isa_t detect_isa(void) {
+#ifdef HAVE_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw")) return ISA_AVX512;
+    if (__builtin_cpu_supports("avx2")) return ISA_AVX2;
+#endif
+    return ISA_GENERIC;
+}
+
+int overlap_batch_lanes(void) {
+    switch (detect_isa()) {
+        case ISA_AVX512: return 64;
+        case ISA_AVX2:   return 32;
+        default:         return 16;
+    }
+}
+
+const char* overlap_batch_isa(void) {
+    switch (detect_isa()) {
+        case ISA_AVX512: return "avx512bw";
+        case ISA_AVX2:   return "avx2";
+        default:         return "generic";
+    }
+}
+
+void soa_reads_build(soa_reads_t* soa, char** strings, const int* lens, const int* order, int count, int depth) {
+    soa->lanes = overlap_batch_lanes();
+    soa->depth = depth > 0 ? depth : 1;
+    soa->num_blocks = (count + soa->lanes - 1) / soa->lanes;
+
+    size_t slots = (size_t)soa->num_blocks * soa->lanes;
+    soa->chars = calloc(slots * soa->depth, 1);
+    soa->ids = malloc((slots + 1) * sizeof(int));
+    soa->block_len = calloc(soa->num_blocks + 1, sizeof(int));
+    if (soa->chars == NULL || soa->ids == NULL || soa->block_len == NULL) {
+        perror("Falha ao alocar memória em soa_reads_build");
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t slot = 0; slot < slots; ++slot) {
+        int block = slot / soa->lanes;
+        int lane = slot % soa->lanes;
+        if ((int)slot >= count) {
+            soa->ids[slot] = -1;
+            continue;
+        }
+        int id = order ? order[slot] : (int)slot;
+        const char* s = strings[id];
+        int stored = lens[id] < soa->depth ? lens[id] : soa->depth;
+        unsigned char* column = soa->chars + (size_t)block * soa->depth * soa->lanes + lane;
+        for (int p = 0; p < stored; ++p) {
+            column[(size_t)p * soa->lanes] = (unsigned char)s[p];
+        }
+        soa->ids[slot] = id;
+        if (stored > soa->block_len[block]) soa->block_len[block] = stored;
+    }
+}
+
+void soa_reads_free(soa_reads_t* soa) {
+    free(soa->chars);
+    free(soa->ids);
+    free(soa->block_len);
+    soa->chars = NULL;
+    soa->ids = NULL;
+    soa->block_len = NULL;
+}
+
+/*
+ * Os três kernels seguem o mesmo esquema: para cada comprimento k (do maior
+ * para o menor) compara-se o sufixo de 'a' de tamanho k, caractere a
+ * caractere, com as k primeiras linhas do bloco, obtendo uma máscara de
+ * faixas que casam. Faixas mais curtas que k nunca casam, porque a posição
+ * além do fim guarda '\0'. Cada faixa fica com o primeiro (maior) k que casa.
+ */
+
+static void kernel_generic(const char* a, int len_a, const unsigned char* rows, int lanes,
+                           int max_k, int* out) {
+    uint64_t all = (lanes == 64) ? ~(uint64_t)0 : (((uint64_t)1 << lanes) - 1);
+    uint64_t found = 0;
+    for (int l = 0; l < lanes; ++l) out[l] = 0;
+
+    for (int k = max_k; k > 0 && found != all; --k) {
+        const unsigned char* suffix = (const unsigned char*)a + len_a - k;
+        uint64_t match = all & ~found;
+        for (int p = 0; p < k && match; ++p) {
+            const unsigned char* row = rows + (size_t)p * lanes;
+            uint64_t eq = 0;
+            for (int l = 0; l < lanes; ++l) {
+                eq |= (uint64_t)(row[l] == suffix[p]) << l;
+            }
+            match &= eq;
+        }
+        for (uint64_t m = match; m; m &= m - 1) {
+            out[__builtin_ctzll(m)] = k;
+        }
+        found |= match;
+    }
+}
+
+#ifdef HAVE_X86_DISPATCH
+__attribute__((target("avx2")))
+static void kernel_avx2(const char* a, int len_a, const unsigned char* rows,
+                        int max_k, int* out) {
+    uint32_t found = 0;
+    for (int l = 0; l < 32; ++l) out[l] = 0;
+
+    for (int k = max_k; k > 0 && found != UINT32_MAX; --k) {
+        const char* suffix = a + len_a - k;
+        uint32_t match = ~found;
+        for (int p = 0; p < k && match; ++p) {
+            __m256i row = _mm256_loadu_si256((const __m256i*)(rows + (size_t)p * 32));
+            __m256i eq = _mm256_cmpeq_epi8(row, _mm256_set1_epi8(suffix[p]));
+            match &= (uint32_t)_mm256_movemask_epi8(eq);
+        }
+        for (uint32_t m = match; m; m &= m - 1) {
+            out[__builtin_ctz(m)] = k;
+        }
+        found |= match;
+    }
+}
+
+__attribute__((target("avx512bw")))
+static void kernel_avx512(const char* a, int len_a, const unsigned char* rows,
+                          int max_k, int* out) {
+    uint64_t found = 0;
+    for (int l = 0; l < 64; ++l) out[l] = 0;
+
+    for (int k = max_k; k > 0 && found != UINT64_MAX; --k) {
+        const char* suffix = a + len_a - k;
+        uint64_t match = ~found;
+        for (int p = 0; p < k && match; ++p) {
+            __m512i row = _mm512_loadu_si512((const void*)(rows + (size_t)p * 64));
+            match &= _mm512_cmpeq_epi8_mask(row, _mm512_set1_epi8(suffix[p]));
+        }
+        for (uint64_t m = match; m; m &= m - 1) {
+            out[__builtin_ctzll(m)] = k;
+        }
+        found |= match;
+    }
+}
+#endif
+
+void overlap_one_vs_block(const char* a, int len_a, const soa_reads_t* soa, int block, int* out) {
+    const unsigned char* rows = soa->chars + (size_t)block * soa->depth * soa->lanes;
+    int max_k = len_a < soa->block_len[block] ? len_a : soa->block_len[block];
+
+#ifdef HAVE_X86_DISPATCH
+    if (soa->lanes == 64) {
+        kernel_avx512(a, len_a, rows, max_k, out);
+        return;
+    }
+    if (soa->lanes == 32) {
+        kernel_avx2(a, len_a, rows, max_k, out);
+        return;
+    }
+#endif
+    kernel_generic(a, len_a, rows, soa->lanes, max_k, out);
+}
+
+int* overlap_matrix_batch(char** strings, const int* lens, int count, bool parallel) {
+    int* matrix = NULL;
+
+    #pragma omp parallel if(parallel)
+    {
+        int* team_matrix = overlap_matrix_batch_team(strings, lens, strings, lens, count, 0, count);
+        #pragma omp master
+        matrix = team_matrix;
+    }
+    return matrix;
+}
+
+int* overlap_matrix_batch_team(char** strings, const int* lens, char** prefixes, const int* prefix_lens,
+                               int count, int row_begin, int row_end) {
+    int* matrix;
+    soa_reads_t soa;
+
+    #pragma omp single copyprivate(matrix, soa)
+    {
+        matrix = malloc((size_t)(row_end - row_begin) * count * sizeof(int) + 1);
+        if (matrix == NULL) {
+            perror("Falha ao alocar memória em overlap_matrix_batch");
+            exit(EXIT_FAILURE);
+        }
+        int max_len = 0;
+        for (int i = 0; i < count; ++i) {
+            if (prefix_lens[i] > max_len) max_len = prefix_lens[i];
+        }
+        soa_reads_build(&soa, prefixes, prefix_lens, NULL, count, max_len);
+    }
+
+    {
+        int* out = malloc(soa.lanes * sizeof(int));
+
+        #pragma omp for schedule(dynamic, 16)
+        for (int i = row_begin; i < row_end; ++i) {
+            int* row = matrix + (size_t)(i - row_begin) * count;
+            for (int block = 0; block < soa.num_blocks; ++block) {
+                overlap_one_vs_block(strings[i], lens[i], &soa, block, out);
+                for (int l = 0; l < soa.lanes; ++l) {
+                    int j = soa.ids[block * soa.lanes + l];
+                    if (j >= 0) row[j] = out[l];
+                }
+            }
+            row[i] = 0;
+        }
+
+        free(out);
+    }
+
+    #pragma omp single
+    soa_reads_free(&soa);
+    return matrix;
+}
@@ -0,0 +1,85 @@
+#ifndef OVERLAP_BATCH_H
+#define OVERLAP_BATCH_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Strings transpostas em blocos (structure-of-arrays) para o kernel
+ * um-contra-muitos. Cada bloco guarda 'lanes' strings: o caractere na
+ * posição p da string da faixa l fica em
+ * chars[(bloco * depth + p) * lanes + l]; posições além do fim da string
+ * (e faixas vazias do último bloco) valem '\0'.
+ */
+typedef struct {
+    int lanes;
+    int depth;
+    int num_blocks;
+    unsigned char* chars;
+    int* ids;           // índice original da string em cada faixa (-1 = vazia)
+    int* block_len;     // maior comprimento de string em cada bloco
+} soa_reads_t;
+
+/**
+ * @brief Número de faixas do kernel escolhido em tempo de execução:
+ * 64 com AVX-512BW, 32 com AVX2 e 16 no caminho genérico.
+ */
+int overlap_batch_lanes(void);
+
+/**
+ * @brief Nome do conjunto de instruções escolhido em tempo de execução.
+ */
+const char* overlap_batch_isa(void);
+
+/**
+ * @brief Monta o layout transposto.
+ * * @param soa Estrutura a preencher; deve ser liberada com soa_reads_free().
+ * @param strings As strings.
+ * @param lens O comprimento de cada string.
+ * @param order Ordem das strings nas faixas (NULL = ordem original).
+ * @param count O número de strings.
+ * @param depth Quantos caracteres de prefixo guardar por string; sobreposições
+ * maiores que 'depth' não são detectadas.
+ */
+void soa_reads_build(soa_reads_t* soa, char** strings, const int* lens, const int* order, int count, int depth);
+
+/**
+ * @brief Libera a memória do layout transposto.
+ */
+void soa_reads_free(soa_reads_t* soa);
+
+/**
+ * @brief Calcula, de uma vez, a maior sobreposição entre os sufixos de 'a' e
+ * os prefixos de todas as strings de um bloco.
+ * * @param a A string cujos sufixos são testados.
+ * @param len_a O comprimento de 'a'.
+ * @param soa O layout transposto.
+ * @param block O bloco a comparar.
+ * @param out Recebe, para cada faixa, o comprimento da sobreposição.
+ */
+void overlap_one_vs_block(const char* a, int len_a, const soa_reads_t* soa, int block, int* out);
+
+/**
+ * @brief Calcula a matriz de sobreposições de todos os pares ordenados com o
+ * kernel um-contra-muitos.
+ * * @param strings As strings.
+ * @param lens O comprimento de cada string.
+ * @param count O número de strings.
+ * @param parallel Se verdadeiro, as linhas da matriz são calculadas em paralelo.
+ * @return Matriz count×count em ordem de linhas (diagonal zero), no mesmo
+ * formato de overlap_matrix_ac(). O chamador deve liberá-la.
+ */
+int* overlap_matrix_batch(char** strings, const int* lens, int count, bool parallel);
+
+/**
+ * @brief Igual a overlap_matrix_batch(), mas deve ser chamada por todas as
+ * threads de uma região paralela já aberta (construções órfãs single/for).
+ * Fora de uma região paralela roda sequencialmente. Só as linhas
+ * [row_begin, row_end) são calculadas. Os sufixos vêm de 'strings' e os
+ * prefixos de 'prefixes' (podem ser as mesmas strings).
+ * @return A mesma matriz (row_end - row_begin)×count para todas as threads;
+ * a linha i fica em [(i - row_begin) * count].
+ */
+int* overlap_matrix_batch_team(char** strings, const int* lens, char** prefixes, const int* prefix_lens,
+                               int count, int row_begin, int row_end);
+
+#endif
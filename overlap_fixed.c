@@ -0,0 +1,121 @@
+#include "overlap_fixed.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Os kernels são instanciados a partir de funções always_inline com o
+ * comprimento como constante: o compilador desenrola os laços e as máscaras
+ * viram imediatos. O byte p de uma palavra carregada com memcpy fica nos
+ * bits 8p a 8p + 7 (little-endian), então o sufixo de tamanho k de 'a' é a
+ * palavra deslocada de 8·(L - k) bits e o prefixo de tamanho k de 'b' é a
+ * palavra com os 8·k bits de baixo.
+ */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ && defined(__SIZEOF_INT128__)
+#define HAVE_WORD_KERNELS 1
+#endif
+
+#ifdef HAVE_WORD_KERNELS
+typedef unsigned __int128 u128_t;
+
+static inline __attribute__((always_inline)) int overlap_word64(const char* a, const char* b, const int len) {
+    uint64_t x = 0, y = 0;
+    memcpy(&x, a, len);
+    memcpy(&y, b, len);
+    #pragma GCC unroll 8
+    for (int k = len; k > 0; --k) {
+        uint64_t mask = (k == 8) ? ~(uint64_t)0 : (((uint64_t)1 << (8 * k)) - 1);
+        if ((x >> (8 * (len - k))) == (y & mask)) return k;
+    }
+    return 0;
+}
+
+static inline __attribute__((always_inline)) int overlap_word128(const char* a, const char* b, const int len) {
+    u128_t x = 0, y = 0;
+    memcpy(&x, a, len);
+    memcpy(&y, b, len);
+    #pragma GCC unroll 16
+    for (int k = len; k > 0; --k) {
+        u128_t mask = (k == 16) ? ~(u128_t)0 : (((u128_t)1 << (8 * k)) - 1);
+        if ((x >> (8 * (len - k))) == (y & mask)) return k;
+    }
+    return 0;
+}
+
+static inline __attribute__((always_inline)) int overlap_long(const char* a, const char* b, const int len) {
+    uint64_t head;
+    memcpy(&head, b, 8);
+    for (int k = len; k >= 8; --k) {
+        uint64_t window;
+        memcpy(&window, a + len - k, 8);
+        if (window == head && memcmp(a + len - k + 8, b + 8, k - 8) == 0) return k;
+    }
+
+    // Sobreposições de menos de 8 bases: as 8 últimas de 'a' numa palavra
+    uint64_t tail;
+    memcpy(&tail, a + len - 8, 8);
+    #pragma GCC unroll 7
+    for (int k = 7; k > 0; --k) {
+        if ((tail >> (8 * (8 - k))) == (head & (((uint64_t)1 << (8 * k)) - 1))) return k;
+    }
+    return 0;
+}
+
+#define DEFINE_FIXED_KERNEL(L, BODY)                                                        \
+    static int overlap_fixed_##L(const char* a, int len_a, const char* b, int len_b) {     \
+        (void)len_a;                                                                        \
+        (void)len_b;                                                                        \
+        return BODY(a, b, L);                                                               \
+    }
+
+DEFINE_FIXED_KERNEL(8, overlap_word64)
+DEFINE_FIXED_KERNEL(9, overlap_word128)
+DEFINE_FIXED_KERNEL(10, overlap_word128)
+DEFINE_FIXED_KERNEL(11, overlap_word128)
+DEFINE_FIXED_KERNEL(12, overlap_word128)
+DEFINE_FIXED_KERNEL(13, overlap_word128)
+DEFINE_FIXED_KERNEL(14, overlap_word128)
+DEFINE_FIXED_KERNEL(15, overlap_word128)
+DEFINE_FIXED_KERNEL(16, overlap_word128)
+DEFINE_FIXED_KERNEL(32, overlap_long)
+DEFINE_FIXED_KERNEL(64, overlap_long)
+DEFINE_FIXED_KERNEL(100, overlap_long)
+DEFINE_FIXED_KERNEL(150, overlap_long)
+
+static const struct {
+    int len;
+    overlap_kernel_t kernel;
+} fixed_kernels[] = {
+    { 8, overlap_fixed_8 },     { 9, overlap_fixed_9 },     { 10, overlap_fixed_10 },
+    { 11, overlap_fixed_11 },   { 12, overlap_fixed_12 },   { 13, overlap_fixed_13 },
+    { 14, overlap_fixed_14 },   { 15, overlap_fixed_15 },   { 16, overlap_fixed_16 },
+    { 32, overlap_fixed_32 },   { 64, overlap_fixed_64 },   { 100, overlap_fixed_100 },
+    { 150, overlap_fixed_150 },
+};
+#endif
+
+overlap_kernel_t overlap_fixed_kernel(int len) {
+#ifdef HAVE_WORD_KERNELS
+    for (size_t k = 0; k < sizeof(fixed_kernels) / sizeof(fixed_kernels[0]); ++k) {
+        if (fixed_kernels[k].len == len) return fixed_kernels[k].kernel;
+    }
+#endif
+    (void)len;
+    return NULL;
+}
+
+overlap_kernel_t overlap_fixed_select(const int* lens, int count, int* fixed_len) {
+    *fixed_len = 0;
+    if (count == 0) return NULL;
+
+    // Um único comprimento em todo o histograma, ou o kernel genérico
+    int single = lens[0];
+    for (int i = 1; i < count && single > 0; ++i) {
+        if (lens[i] != single) single = 0;
+    }
+
+    overlap_kernel_t kernel = single > 0 ? overlap_fixed_kernel(single) : NULL;
+    if (kernel != NULL) *fixed_len = single;
+    return kernel;
+}
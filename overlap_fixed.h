@@ -0,0 +1,34 @@
+#ifndef OVERLAP_FIXED_H
+#define OVERLAP_FIXED_H
+
+/**
+ * @brief Kernel de sobreposição por par, com a assinatura de
+ * calculate_overlap_simd().
+ */
+typedef int (*overlap_kernel_t)(const char* a, int len_a, const char* b, int len_b);
+
+/**
+ * @brief Kernels especializados para leituras de comprimento fixo (8 a 16,
+ * 32, 64, 100 e 150). Cada um é gerado para um comprimento constante: até
+ * 16 bases as duas leituras viram uma palavra de 64 ou 128 bits e cada
+ * sobreposição é um deslocamento e uma máscara, com o laço desenrolado;
+ * acima disso as 8 primeiras bases de 'b' descartam quase todos os
+ * candidatos com uma comparação de palavra. Só valem para pares em que as
+ * duas strings têm exatamente esse comprimento.
+ * * @param len O comprimento.
+ * @return O kernel, ou NULL se não há especialização para 'len'.
+ */
+overlap_kernel_t overlap_fixed_kernel(int len);
+
+/**
+ * @brief Escolhe o kernel pelos comprimentos das leituras: se todas têm o
+ * mesmo comprimento e há especialização para ele, devolve o kernel;
+ * leituras de comprimentos misturados ficam com o kernel genérico.
+ * * @param lens O comprimento de cada leitura.
+ * @param count O número de leituras.
+ * @param fixed_len Recebe o comprimento do kernel escolhido (0 se nenhum).
+ * @return O kernel, ou NULL para usar calculate_overlap_simd().
+ */
+overlap_kernel_t overlap_fixed_select(const int* lens, int count, int* fixed_len);
+
+#endif
@@ -0,0 +1,246 @@
+#include "overlap_store.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+static void* checked_malloc(size_t size) {
+    void* p = malloc(size);
+    if (p == NULL && size > 0) {
+        perror("Falha ao alocar memória em overlap_store");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+static int varint_len(uint32_t v) {
+    int n = 1;
+    while (v >= 0x80) {
+        v >>= 7;
+        n++;
+    }
+    return n;
+}
+
+static int put_varint(uint8_t* out, uint32_t v) {
+    int n = 0;
+    while (v >= 0x80) {
+        out[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+static uint32_t get_varint(const uint8_t* data, int* offset) {
+    uint32_t v = 0;
+    int shift = 0;
+    for (;;) {
+        uint8_t byte = data[(*offset)++];
+        v |= (uint32_t)(byte & 0x7f) << shift;
+        if (byte < 0x80) return v;
+        shift += 7;
+    }
+}
+
+int overlap_store_k_for_budget(size_t budget, int count, int max_len) {
+    if (count <= 0) return INT_MAX;
+    // Descritor da linha e o cabeçalho do malloc dos dados; por candidato,
+    // o grupo (sobreposição de até max_len, quantidade 1) e o rank
+    size_t per_row = sizeof(store_row_t) + 16;
+    size_t per_edge = varint_len((uint32_t)max_len) + 1 + varint_len((uint32_t)count);
+    if (budget <= (size_t)count * per_row) return 0;
+    size_t k = (budget - (size_t)count * per_row) / ((size_t)count * per_edge);
+    return k > INT_MAX ? INT_MAX : (int)k;
+}
+
+/*
+ * Seleção dos k melhores pares (sobreposição, rank) com um heap cuja raiz é
+ * o pior dos guardados: um candidato só entra se for melhor que ela.
+ */
+static bool pair_worse(const int* x, const int* y) {
+    if (x[0] != y[0]) return x[0] < y[0];
+    return x[1] > y[1];
+}
+
+static void select_push(int* heap, int* size, int k, int ov, int rank) {
+    int c[2] = { ov, rank };
+    int pos;
+    if (*size < k) {
+        pos = (*size)++;
+        while (pos > 0) {
+            int parent = (pos - 1) / 2;
+            if (!pair_worse(c, &heap[2 * parent])) break;
+            heap[2 * pos] = heap[2 * parent];
+            heap[2 * pos + 1] = heap[2 * parent + 1];
+            pos = parent;
+        }
+    } else {
+        if (!pair_worse(&heap[0], c)) return;
+        pos = 0;
+        for (;;) {
+            int child = 2 * pos + 1;
+            if (child >= *size) break;
+            if (child + 1 < *size && pair_worse(&heap[2 * (child + 1)], &heap[2 * child])) child++;
+            if (!pair_worse(&heap[2 * child], c)) break;
+            heap[2 * pos] = heap[2 * child];
+            heap[2 * pos + 1] = heap[2 * child + 1];
+            pos = child;
+        }
+    }
+    heap[2 * pos] = c[0];
+    heap[2 * pos + 1] = c[1];
+}
+
+static int compare_pairs(const void* x, const void* y) {
+    const int* a = x;
+    const int* b = y;
+    if (a[0] != b[0]) return a[0] > b[0] ? -1 : 1;
+    return (a[1] > b[1]) - (a[1] < b[1]);
+}
+
+/**
+ * @brief (Re)carrega a linha 'a' com os k melhores candidatos depois do
+ * último guardado.
+ * @return A variação no número de bytes comprimidos.
+ */
+static long long row_load(overlap_store_t* store, int a, int* buffer, int* heap) {
+    store_row_t* row = &store->rows[a];
+    long long old_bytes = row->bytes;
+
+    int m = store->row_fn(store->ctx, a, buffer);
+    int size = 0;
+    int remaining = 0;
+    for (int e = 0; e < m; ++e) {
+        int ov = buffer[2 * e + 1];
+        int r = store->rank[buffer[2 * e]];
+        if (ov > row->tail_ov || (ov == row->tail_ov && r <= row->tail_rank)) continue;
+        remaining++;
+        select_push(heap, &size, store->k, ov, r);
+    }
+    qsort(heap, size, 2 * sizeof(int), compare_pairs);
+
+    free(row->data);
+    row->data = NULL;
+    row->bytes = 0;
+    if (size > 0) {
+        uint8_t* data = checked_malloc((size_t)size * 15);
+        int n = 0;
+        for (int e = 0; e < size;) {
+            int g_end = e;
+            while (g_end < size && heap[2 * g_end] == heap[2 * e]) g_end++;
+            n += put_varint(data + n, (uint32_t)heap[2 * e]);
+            n += put_varint(data + n, (uint32_t)(g_end - e));
+            for (int x = e; x < g_end; ++x) {
+                uint32_t v = (x == e) ? (uint32_t)heap[2 * x + 1] : (uint32_t)(heap[2 * x + 1] - heap[2 * (x - 1) + 1]);
+                n += put_varint(data + n, v);
+            }
+            e = g_end;
+        }
+        row->data = realloc(data, n);
+        row->bytes = n;
+        row->tail_ov = heap[2 * (size - 1)];
+        row->tail_rank = heap[2 * (size - 1) + 1];
+    }
+    row->offset = 0;
+    row->group_left = 0;
+    row->last_rank = -1;
+    row->front_b = -1;
+    row->complete = remaining <= store->k;
+    return (long long)row->bytes - old_bytes;
+}
+
+void overlap_store_init(overlap_store_t* store, int count, int k, const int* rank, const int* by_rank,
+                        overlap_row_fn row_fn, void* ctx) {
+    store->count = count;
+    store->k = k < 1 ? 1 : (k > count ? count : k);
+    store->rank = rank;
+    store->by_rank = by_rank;
+    store->rows = calloc(count + 1, sizeof(store_row_t));
+    if (store->rows == NULL) {
+        perror("Falha ao alocar memória em overlap_store");
+        exit(EXIT_FAILURE);
+    }
+    store->row_fn = row_fn;
+    store->ctx = ctx;
+    store->refills = 0;
+    store->buffer = checked_malloc((2 * (size_t)count + 1) * sizeof(int));
+    store->heap = checked_malloc((2 * (size_t)store->k + 1) * sizeof(int));
+
+    long long bytes = 0;
+    #pragma omp parallel reduction(+:bytes)
+    {
+        int* buffer = checked_malloc((2 * (size_t)count + 1) * sizeof(int));
+        int* heap = checked_malloc((2 * (size_t)store->k + 1) * sizeof(int));
+
+        #pragma omp for schedule(dynamic, 16)
+        for (int a = 0; a < count; ++a) {
+            store->rows[a].tail_ov = INT_MAX;
+            store->rows[a].tail_rank = -1;
+            bytes += row_load(store, a, buffer, heap);
+        }
+
+        free(buffer);
+        free(heap);
+    }
+    store->bytes = bytes;
+    store->peak_bytes = bytes;
+}
+
+bool overlap_store_front(overlap_store_t* store, int a, int* b, int* overlap) {
+    store_row_t* row = &store->rows[a];
+    for (;;) {
+        if (row->front_b >= 0) {
+            *b = row->front_b;
+            *overlap = row->front_ov;
+            return true;
+        }
+        if (row->group_left == 0 && row->offset == row->bytes) {
+            if (row->complete) return false;
+            store->bytes += row_load(store, a, store->buffer, store->heap);
+            if (store->bytes > store->peak_bytes) store->peak_bytes = store->bytes;
+            store->refills++;
+            continue;
+        }
+        if (row->group_left == 0) {
+            row->group_ov = (int)get_varint(row->data, &row->offset);
+            row->group_left = (int)get_varint(row->data, &row->offset);
+            row->last_rank = -1;
+        }
+        uint32_t v = get_varint(row->data, &row->offset);
+        int r = row->last_rank < 0 ? (int)v : row->last_rank + (int)v;
+        row->last_rank = r;
+        row->group_left--;
+        row->front_b = store->by_rank[r];
+        row->front_ov = row->group_ov;
+    }
+}
+
+void overlap_store_pop(overlap_store_t* store, int a) {
+    int b, ov;
+    if (overlap_store_front(store, a, &b, &ov)) store->rows[a].front_b = -1;
+}
+
+void overlap_store_release(overlap_store_t* store, int a) {
+    store_row_t* row = &store->rows[a];
+    store->bytes -= row->bytes;
+    free(row->data);
+    row->data = NULL;
+    row->bytes = 0;
+    row->offset = 0;
+    row->group_left = 0;
+    row->front_b = -1;
+    row->complete = true;
+}
+
+void overlap_store_free(overlap_store_t* store) {
+    for (int a = 0; a < store->count; ++a) free(store->rows[a].data);
+    free(store->rows);
+    free(store->buffer);
+    free(store->heap);
+    store->rows = NULL;
+    store->buffer = NULL;
+    store->heap = NULL;
+}
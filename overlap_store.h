@@ -0,0 +1,107 @@
+#ifndef OVERLAP_STORE_H
+#define OVERLAP_STORE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Calcula os candidatos de saída de uma leitura.
+ * * @param ctx Contexto do chamador.
+ * @param a A leitura de origem.
+ * @param out Recebe os pares (destino, sobreposição), em ordem arbitrária;
+ * tem espaço para 2 × count inteiros.
+ * @return O número de pares.
+ */
+typedef int (*overlap_row_fn)(void* ctx, int a, int* out);
+
+/**
+ * @brief Linha de candidatos de uma leitura, comprimida: grupos (sobreposição,
+ * quantidade) em ordem decrescente de sobreposição, cada um seguido dos
+ * ranks dos destinos em ordem crescente, em diferenças codificadas como
+ * varint. O cursor decodifica um candidato de cada vez.
+ */
+typedef struct {
+    uint8_t* data;
+    int bytes;
+    int offset;             // próximo byte a decodificar
+    int group_ov;           // sobreposição do grupo atual
+    int group_left;         // destinos ainda não decodificados no grupo atual
+    int last_rank;          // rank do último destino decodificado (-1 no início do grupo)
+    int front_b;            // candidato da frente (-1 = ainda não decodificado)
+    int front_ov;
+    int tail_ov;            // último candidato guardado: a recarga continua dele
+    int tail_rank;
+    bool complete;          // a linha guardou todos os candidatos que restavam
+} store_row_t;
+
+/**
+ * @brief Armazém esparso de sobreposições: guarda, para cada leitura, só os
+ * k melhores candidatos de saída (maior sobreposição, depois menor rank de
+ * destino), na ordem em que a gulosa os consome. Quando os candidatos de uma
+ * linha acabam e ainda pode haver outros, a linha é recalculada e guarda os
+ * k seguintes. A memória fica em O(n·k) em vez da matriz n×n.
+ */
+typedef struct {
+    int count;
+    int k;
+    const int* rank;
+    const int* by_rank;
+    store_row_t* rows;
+    overlap_row_fn row_fn;
+    void* ctx;
+    size_t bytes;           // bytes comprimidos vivos
+    size_t peak_bytes;
+    long long refills;
+    int* buffer;            // rascunho das recargas feitas fora da carga inicial
+    int* heap;
+} overlap_store_t;
+
+/**
+ * @brief Maior k cujo armazém cabe em 'budget' bytes no pior caso (cada
+ * candidato num grupo próprio, com a sobreposição, a quantidade e o rank
+ * inteiros).
+ * * @param budget Bytes disponíveis para as linhas e os seus descritores.
+ * @param count O número de leituras.
+ * @param max_len O comprimento da maior leitura (limita a sobreposição).
+ * @return O k, ou 0 se nem um candidato por leitura cabe.
+ */
+int overlap_store_k_for_budget(size_t budget, int count, int max_len);
+
+/**
+ * @brief Cria o armazém e carrega todas as linhas, em paralelo.
+ * * @param store O armazém.
+ * @param count O número de leituras.
+ * @param k Candidatos guardados por linha.
+ * @param rank O rank de cada leitura (ordem dos destinos).
+ * @param by_rank A leitura de cada rank.
+ * @param row_fn Calcula os candidatos de uma leitura; é chamada em paralelo
+ * na carga inicial e depois por uma thread só.
+ * @param ctx Contexto de 'row_fn'.
+ */
+void overlap_store_init(overlap_store_t* store, int count, int k, const int* rank, const int* by_rank,
+                        overlap_row_fn row_fn, void* ctx);
+
+/**
+ * @brief Candidato da frente da linha 'a', recarregando a linha se ela
+ * acabou e não estava completa.
+ * @return false se a leitura não tem mais candidatos.
+ */
+bool overlap_store_front(overlap_store_t* store, int a, int* b, int* overlap);
+
+/**
+ * @brief Descarta o candidato da frente da linha 'a'.
+ */
+void overlap_store_pop(overlap_store_t* store, int a);
+
+/**
+ * @brief Descarta a linha 'a' inteira (a leitura não precisa de mais candidatos).
+ */
+void overlap_store_release(overlap_store_t* store, int a);
+
+/**
+ * @brief Libera o armazém.
+ */
+void overlap_store_free(overlap_store_t* store);
+
+#endif
@@ -0,0 +1,75 @@
+#include "packed_dna.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static int base_code(char c) {
+    switch (c) {
+        case 'A': return 0;
+        case 'C': return 1;
+        case 'G': return 2;
+        case 'T': return 3;
+        default:  return -1;
+    }
+}
+
+bool pack_read(const char* s, int len, packed_read_t* out) {
+    int num_words = len / 32 + 2;
+
+    out->words = calloc(num_words, sizeof(uint64_t));
+    if (out->words == NULL) {
+        perror("Falha ao alocar memória em pack_read");
+        exit(EXIT_FAILURE);
+    }
+    out->len = len;
+
+    for (int k = 0; k < len; ++k) {
+        int code = base_code(s[k]);
+        if (code < 0) {
+            packed_read_free(out);
+            return false;
+        }
+        out->words[k / 32] |= (uint64_t)code << (2 * (k % 32));
+    }
+    return true;
+}
+
+void packed_read_free(packed_read_t* r) {
+    free(r->words);
+    r->words = NULL;
+    r->len = 0;
+}
+
+/**
+ * @brief Lê as 32 bases que começam na posição 'pos'.
+ */
+static inline uint64_t window32(const uint64_t* words, int pos) {
+    int w = pos / 32;
+    int shift = 2 * (pos % 32);
+    if (shift == 0) return words[w];
+    return (words[w] >> shift) | (words[w + 1] << (64 - shift));
+}
+
+int calculate_overlap_packed(const packed_read_t* a, const packed_read_t* b) {
+    int min_length = (a->len < b->len) ? a->len : b->len;
+
+    // Itera do maior overlap possível para o menor
+    for (int i = min_length; i > 0; --i) {
+        int start = a->len - i;
+        bool is_match = true;
+
+        for (int k = 0; k < i && is_match; k += 32) {
+            int remaining = i - k;
+            uint64_t diff = window32(a->words, start + k) ^ window32(b->words, k);
+            if (remaining < 32) {
+                diff &= ((uint64_t)1 << (2 * remaining)) - 1;
+            }
+            is_match = (diff == 0);
+        }
+
+        if (is_match) {
+            return i;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,41 @@
+#ifndef PACKED_DNA_H
+#define PACKED_DNA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Leitura de DNA compactada com 2 bits por base (A=0, C=1, G=2, T=3).
+ * A base k fica nos bits 2*(k%32) e 2*(k%32)+1 da palavra k/32. Há sempre
+ * uma palavra extra zerada no fim, para que janelas de 32 bases possam ser
+ * lidas a partir de qualquer posição sem testes de limite.
+ */
+typedef struct {
+    uint64_t* words;
+    int len;
+} packed_read_t;
+
+/**
+ * @brief Compacta uma string de DNA.
+ * * @param s A string (apenas 'A', 'C', 'G' e 'T' são aceitos).
+ * @param len O comprimento da string.
+ * @param out Leitura compactada; deve ser liberada com packed_read_free().
+ * @return false se a string contém algum caractere fora de ACGT.
+ */
+bool pack_read(const char* s, int len, packed_read_t* out);
+
+/**
+ * @brief Libera a memória de uma leitura compactada.
+ */
+void packed_read_free(packed_read_t* r);
+
+/**
+ * @brief Calcula o comprimento do maior sufixo de 'a' que é também um
+ * prefixo de 'b', comparando janelas de 32 bases com um único XOR.
+ * * @param a A primeira leitura compactada.
+ * @param b A segunda leitura compactada.
+ * @return O comprimento da sobreposição.
+ */
+int calculate_overlap_packed(const packed_read_t* a, const packed_read_t* b);
+
+#endif
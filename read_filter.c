@@ -0,0 +1,76 @@
+#include "read_filter.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "overlap_ac.h"
+
+static uint64_t hash_read(const char* s, int len) {
+    // FNV-1a de 64 bits
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (int k = 0; k < len; ++k) {
+        h ^= (unsigned char)s[k];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+/**
+ * @brief Remove as repetidas com uma tabela de endereçamento aberto que
+ * guarda o índice da primeira ocorrência de cada leitura.
+ */
+static int remove_duplicates(char** strings, int* lens, int count) {
+    size_t capacity = 16;
+    while (capacity < 2 * (size_t)count) capacity *= 2;
+    int* table = malloc(capacity * sizeof(int));
+    if (table == NULL) {
+        perror("Falha ao alocar memória em read_filter_apply");
+        exit(EXIT_FAILURE);
+    }
+    memset(table, -1, capacity * sizeof(int));
+
+    int kept = 0;
+    for (int i = 0; i < count; ++i) {
+        size_t slot = hash_read(strings[i], lens[i]) & (capacity - 1);
+        bool duplicate = false;
+        while (table[slot] >= 0) {
+            int j = table[slot];
+            if (lens[j] == lens[i] && memcmp(strings[j], strings[i], lens[i]) == 0) {
+                duplicate = true;
+                break;
+            }
+            slot = (slot + 1) & (capacity - 1);
+        }
+        if (duplicate) continue;
+
+        strings[kept] = strings[i];
+        lens[kept] = lens[i];
+        table[slot] = kept;
+        kept++;
+    }
+
+    free(table);
+    return kept;
+}
+
+int read_filter_apply(char** strings, int* lens, int count, bool parallel, read_filter_stats_t* stats) {
+    int distinct = remove_duplicates(strings, lens, count);
+
+    bool* contained = contained_strings_ac(strings, lens, distinct, parallel);
+    int kept = 0;
+    for (int i = 0; i < distinct; ++i) {
+        if (contained[i]) continue;
+        strings[kept] = strings[i];
+        lens[kept] = lens[i];
+        kept++;
+    }
+    free(contained);
+
+    if (stats != NULL) {
+        stats->duplicates = count - distinct;
+        stats->contained = distinct - kept;
+    }
+    return kept;
+}
@@ -0,0 +1,28 @@
+#ifndef READ_FILTER_H
+#define READ_FILTER_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Quantas leituras o pré-filtro removeu.
+ */
+typedef struct {
+    int duplicates;
+    int contained;
+} read_filter_stats_t;
+
+/**
+ * @brief Pré-filtro aplicado antes da fase gulosa: remove leituras
+ * repetidas (tabela hash; fica a primeira ocorrência) e leituras contidas
+ * em outra (autômato de Aho-Corasick, contained_strings_ac). As leituras
+ * restantes são compactadas no início dos vetores, na ordem original.
+ * * @param strings As leituras (o vetor de ponteiros é reescrito).
+ * @param lens O comprimento de cada leitura (reescrito junto).
+ * @param count O número de leituras.
+ * @param parallel Se verdadeiro, a busca de contidas roda em paralelo.
+ * @param stats Se não for NULL, recebe quantas leituras foram removidas.
+ * @return O novo número de leituras.
+ */
+int read_filter_apply(char** strings, int* lens, int count, bool parallel, read_filter_stats_t* stats);
+
+#endif
@@ -0,0 +1,319 @@
+#include "read_loader.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <omp.h>
+
+// Pedaços menores que isso não compensam o custo de uma tarefa
+#define MIN_CHUNK_BYTES (1 << 16)
+
+/**
+ * @brief Conteúdo completo da entrada: mapeado do arquivo ou copiado de um pipe.
+ */
+typedef struct {
+    const char* data;
+    size_t size;
+    bool mapped;
+} input_buffer_t;
+
+static bool is_blank(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * @brief Lê tudo o que resta em 'fd' para um buffer alocado.
+ */
+static bool read_all(int fd, input_buffer_t* in) {
+    size_t capacity = 1 << 20;
+    size_t size = 0;
+    char* data = malloc(capacity);
+    if (data == NULL) {
+        perror("Falha ao alocar memória para a entrada");
+        return false;
+    }
+    for (;;) {
+        if (size == capacity) {
+            capacity *= 2;
+            char* bigger = realloc(data, capacity);
+            if (bigger == NULL) {
+                perror("Falha ao alocar memória para a entrada");
+                free(data);
+                return false;
+            }
+            data = bigger;
+        }
+        ssize_t got = read(fd, data + size, capacity - size);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            perror("Erro ao ler a entrada");
+            free(data);
+            return false;
+        }
+        if (got == 0) break;
+        size += got;
+    }
+    in->data = data;
+    in->size = size;
+    in->mapped = false;
+    return true;
+}
+
+/**
+ * @brief Abre a entrada: arquivos regulares são mapeados em memória;
+ * pipes e terminais são lidos de uma vez.
+ */
+static bool input_open(const char* path, input_buffer_t* in) {
+    int fd = STDIN_FILENO;
+    if (path != NULL) {
+        fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            fprintf(stderr, "Não foi possível abrir %s: %s\n", path, strerror(errno));
+            return false;
+        }
+    }
+
+    bool ok;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void* p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            madvise(p, st.st_size, MADV_SEQUENTIAL);
+            in->data = p;
+            in->size = st.st_size;
+            in->mapped = true;
+            ok = true;
+        } else {
+            ok = read_all(fd, in);
+        }
+    } else {
+        ok = read_all(fd, in);
+    }
+
+    if (path != NULL) close(fd);
+    return ok;
+}
+
+static void input_close(input_buffer_t* in) {
+    if (in->mapped) {
+        munmap((void*)in->data, in->size);
+    } else {
+        free((void*)in->data);
+    }
+}
+
+/**
+ * @brief Posição logo após o próximo '\n' a partir de 'pos' (ou 'end').
+ */
+static size_t next_line(const char* data, size_t end, size_t pos) {
+    const char* nl = memchr(data + pos, '\n', end - pos);
+    return nl ? (size_t)(nl - data) + 1 : end;
+}
+
+/**
+ * @brief Copia (ou só conta, se dst == NULL) os caracteres não brancos de
+ * data[begin, end).
+ */
+static int copy_sequence(char* dst, const char* data, size_t begin, size_t end) {
+    int n = 0;
+    for (size_t p = begin; p < end; ++p) {
+        if (!is_blank(data[p])) {
+            if (dst) dst[n] = data[p];
+            n++;
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief Primeira fronteira de registro em [pos, size).
+ * Em FASTQ um '@' no início de linha pode ser o começo de uma linha de
+ * qualidade; só é aceito como cabeçalho se a linha dois abaixo começar
+ * com '+'.
+ */
+static size_t record_boundary(input_format_t format, const char* data, size_t size, size_t pos) {
+    if (format == INPUT_COUNTED) {
+        while (pos < size && !is_blank(data[pos - 1])) pos++;
+        return pos;
+    }
+
+    if (data[pos - 1] != '\n') pos = next_line(data, size, pos);
+    while (pos < size) {
+        if (format == INPUT_FASTA && data[pos] == '>') return pos;
+        if (format == INPUT_FASTQ && data[pos] == '@') {
+            size_t plus = next_line(data, size, next_line(data, size, pos));
+            if (plus < size && data[plus] == '+') return pos;
+        }
+        pos = next_line(data, size, pos);
+    }
+    return size;
+}
+
+/**
+ * @brief Percorre os registros de data[begin, end). Sem 'store' apenas
+ * conta leituras e bytes de arena (comprimento + 1 de cada uma); com
+ * 'store' escreve as leituras a partir da leitura 'first' e do byte
+ * 'first_byte' da arena. Registros FASTA/FASTQ sem bases são ignorados.
+ */
+static void scan_chunk(input_format_t format, const char* data, size_t begin, size_t end,
+                       int* count, size_t* bytes,
+                       read_store_t* store, int first, size_t first_byte) {
+    int k = 0;
+    size_t used = 0;
+    size_t pos = begin;
+
+    while (pos < end) {
+        while (pos < end && is_blank(data[pos])) pos++;
+        if (pos >= end) break;
+
+        size_t seq_begin, seq_end;
+        if (format == INPUT_COUNTED) {
+            seq_begin = pos;
+            while (pos < end && !is_blank(data[pos])) pos++;
+            seq_end = pos;
+        } else if (format == INPUT_FASTA) {
+            seq_begin = next_line(data, end, pos);
+            pos = seq_begin;
+            while (pos < end && data[pos] != '>') pos = next_line(data, end, pos);
+            seq_end = pos;
+        } else {
+            seq_begin = next_line(data, end, pos);
+            seq_end = next_line(data, end, seq_begin);
+            pos = next_line(data, end, next_line(data, end, seq_end));
+        }
+
+        char* dst = store ? store->arena + first_byte + used : NULL;
+        int len = copy_sequence(dst, data, seq_begin, seq_end);
+        if (len == 0 && format != INPUT_COUNTED) continue;
+
+        if (store) {
+            dst[len] = '\0';
+            store->offset[first + k] = first_byte + used;
+            store->len[first + k] = len;
+        }
+        used += len + 1;
+        k++;
+    }
+
+    if (count) *count = k;
+    if (bytes) *bytes = used;
+}
+
+/**
+ * @brief Lê o número de leituras no início do formato com contagem.
+ * * @return A posição logo após o número, ou 0 se ele for inválido.
+ */
+static size_t parse_count(const char* data, size_t size, size_t pos, int* n) {
+    long long value = 0;
+    size_t start = pos;
+    while (pos < size && data[pos] >= '0' && data[pos] <= '9') {
+        value = value * 10 + (data[pos] - '0');
+        if (value > 0x7fffffff) return 0;
+        pos++;
+    }
+    if (pos == start || (pos < size && !is_blank(data[pos]))) return 0;
+    *n = (int)value;
+    return pos;
+}
+
+bool read_loader_load(const char* path, read_store_t* store, input_format_t* format) {
+    input_buffer_t in;
+    if (!input_open(path, &in)) {
+        return false;
+    }
+
+    const char* data = in.data;
+    size_t pos = 0;
+    while (pos < in.size && is_blank(data[pos])) pos++;
+
+    input_format_t fmt;
+    int expected = -1;
+    if (pos < in.size && data[pos] == '>') {
+        fmt = INPUT_FASTA;
+    } else if (pos < in.size && data[pos] == '@') {
+        fmt = INPUT_FASTQ;
+    } else {
+        fmt = INPUT_COUNTED;
+        pos = parse_count(data, in.size, pos, &expected);
+        if (pos == 0) {
+            fprintf(stderr, "Entrada inválida para o número de strings.\n");
+            input_close(&in);
+            return false;
+        }
+    }
+
+    // Fronteiras dos pedaços, ajustadas para o início de um registro
+    size_t body = in.size - pos;
+    int num_chunks = 4 * omp_get_max_threads();
+    if ((size_t)num_chunks > body / MIN_CHUNK_BYTES + 1) {
+        num_chunks = body / MIN_CHUNK_BYTES + 1;
+    }
+    size_t* bounds = malloc((num_chunks + 1) * sizeof(size_t));
+    int* counts = malloc(num_chunks * sizeof(int));
+    size_t* bytes = malloc(num_chunks * sizeof(size_t));
+    int* first = malloc(num_chunks * sizeof(int));
+    size_t* first_byte = malloc(num_chunks * sizeof(size_t));
+
+    bounds[0] = pos;
+    bounds[num_chunks] = in.size;
+    for (int c = 1; c < num_chunks; ++c) {
+        size_t guess = pos + body / num_chunks * c;
+        if (guess < bounds[c - 1]) guess = bounds[c - 1];
+        bounds[c] = guess > pos ? record_boundary(fmt, data, in.size, guess) : pos;
+    }
+
+    // 1ª passada: leituras e bytes por pedaço; 2ª passada: escrita direta
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int c = 0; c < num_chunks; ++c) {
+        scan_chunk(fmt, data, bounds[c], bounds[c + 1], &counts[c], &bytes[c], NULL, 0, 0);
+    }
+
+    long long total = 0;
+    size_t total_bytes = 0;
+    for (int c = 0; c < num_chunks; ++c) {
+        first[c] = (int)total;
+        first_byte[c] = total_bytes;
+        total += counts[c];
+        total_bytes += bytes[c];
+    }
+
+    bool ok = true;
+    if (total > 0x7fffffff) {
+        fprintf(stderr, "Entrada com leituras demais.\n");
+        ok = false;
+    } else if (fmt == INPUT_COUNTED && total < expected) {
+        fprintf(stderr, "Erro ao ler a string %lld.\n", total + 1);
+        ok = false;
+    }
+
+    if (ok) {
+        read_store_init(store, (int)total);
+        read_store_resize(store, (int)total, total_bytes);
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int c = 0; c < num_chunks; ++c) {
+            scan_chunk(fmt, data, bounds[c], bounds[c + 1], NULL, NULL, store, first[c], first_byte[c]);
+        }
+
+        // Leituras além da quantidade anunciada são descartadas
+        if (fmt == INPUT_COUNTED && total > expected) {
+            store->count = expected;
+            store->size = expected > 0
+                ? store->offset[expected - 1] + store->len[expected - 1] + 1 : 0;
+        }
+        if (format) *format = fmt;
+    }
+
+    free(bounds);
+    free(counts);
+    free(bytes);
+    free(first);
+    free(first_byte);
+    input_close(&in);
+    return ok;
+}
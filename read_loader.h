@@ -0,0 +1,31 @@
+#ifndef READ_LOADER_H
+#define READ_LOADER_H
+
+#include <stdbool.h>
+
+#include "read_store.h"
+
+/**
+ * @brief Formatos de entrada reconhecidos pelo carregador.
+ */
+typedef enum {
+    INPUT_COUNTED,  // número de leituras seguido das leituras separadas por espaços
+    INPUT_FASTA,    // registros '>' com sequência em uma ou mais linhas
+    INPUT_FASTQ     // registros de quatro linhas '@', sequência, '+', qualidade
+} input_format_t;
+
+/**
+ * @brief Carrega todas as leituras de um arquivo para um conjunto novo.
+ * O arquivo é mapeado em memória (ou lido de uma vez, se for um pipe),
+ * dividido em pedaços que começam em fronteiras de registro e
+ * tokenizado em paralelo direto para a arena, sem limite de comprimento.
+ * O formato é detectado pelo primeiro caractere não branco.
+ * * @param path Caminho do arquivo, ou NULL para a entrada padrão.
+ * @param store Conjunto a inicializar e preencher.
+ * @param format Se não for NULL, recebe o formato detectado.
+ * @return true em caso de sucesso; em caso de erro imprime a causa e
+ * o conjunto não precisa ser liberado.
+ */
+bool read_loader_load(const char* path, read_store_t* store, input_format_t* format);
+
+#endif
@@ -0,0 +1,133 @@
+#include "read_store.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define POOL_BLOCK_SIZE (1 << 20)
+
+static void* checked_realloc(void* p, size_t size) {
+    void* q = realloc(p, size);
+    if (q == NULL && size > 0) {
+        perror("Falha ao alocar memória para o conjunto de leituras");
+        exit(EXIT_FAILURE);
+    }
+    return q;
+}
+
+void read_store_init(read_store_t* store, int expected_count) {
+    store->count = 0;
+    store->max_count = expected_count > 0 ? expected_count : 16;
+    store->size = 0;
+    store->capacity = (size_t)store->max_count * 16;
+    store->arena = checked_realloc(NULL, store->capacity);
+    store->offset = checked_realloc(NULL, store->max_count * sizeof(size_t));
+    store->len = checked_realloc(NULL, store->max_count * sizeof(int));
+}
+
+void read_store_add(read_store_t* store, const char* s, int len) {
+    if (store->count == store->max_count) {
+        store->max_count *= 2;
+        store->offset = checked_realloc(store->offset, store->max_count * sizeof(size_t));
+        store->len = checked_realloc(store->len, store->max_count * sizeof(int));
+    }
+    if (store->size + len + 1 > store->capacity) {
+        while (store->size + len + 1 > store->capacity) store->capacity *= 2;
+        store->arena = checked_realloc(store->arena, store->capacity);
+    }
+
+    memcpy(store->arena + store->size, s, len);
+    store->arena[store->size + len] = '\0';
+    store->offset[store->count] = store->size;
+    store->len[store->count] = len;
+    store->size += len + 1;
+    store->count++;
+}
+
+void read_store_resize(read_store_t* store, int count, size_t size) {
+    if (count > store->max_count) {
+        store->max_count = count;
+        store->offset = checked_realloc(store->offset, store->max_count * sizeof(size_t));
+        store->len = checked_realloc(store->len, store->max_count * sizeof(int));
+    }
+    if (size + 1 > store->capacity) {
+        store->capacity = size + 1;
+        store->arena = checked_realloc(store->arena, store->capacity);
+    }
+    store->count = count;
+    store->size = size;
+}
+
+void read_store_free(read_store_t* store) {
+    free(store->arena);
+    free(store->offset);
+    free(store->len);
+    store->arena = NULL;
+    store->offset = NULL;
+    store->len = NULL;
+    store->count = 0;
+}
+
+void string_pool_init(string_pool_t* pool) {
+    pool->top = NULL;
+    pool->bytes = 0;
+}
+
+char* string_pool_alloc(string_pool_t* pool, size_t size) {
+    if (pool->top == NULL || pool->top->used + size > pool->top->capacity) {
+        size_t capacity = size > POOL_BLOCK_SIZE ? size : POOL_BLOCK_SIZE;
+        pool_block_t* block = malloc(sizeof(pool_block_t) + capacity);
+        if (block == NULL) {
+            perror("Falha ao alocar memória em string_pool_alloc");
+            exit(EXIT_FAILURE);
+        }
+        block->prev = pool->top;
+        block->used = 0;
+        block->capacity = capacity;
+        pool->top = block;
+    }
+
+    char* p = pool->top->data + pool->top->used;
+    pool->top->used += size;
+    pool->bytes += size;
+    return p;
+}
+
+void string_pool_release(string_pool_t* pool) {
+    while (pool->top != NULL) {
+        pool_block_t* prev = pool->top->prev;
+        free(pool->top);
+        pool->top = prev;
+    }
+    pool->bytes = 0;
+}
+
+void string_pool_compact(string_pool_t* pool, char** strings, const int* lens, int count) {
+    string_pool_t fresh;
+    char* arena;
+    size_t* offset;
+
+    #pragma omp single copyprivate(fresh, arena, offset)
+    {
+        offset = checked_realloc(NULL, (count + 1) * sizeof(size_t));
+        offset[0] = 0;
+        for (int k = 0; k < count; ++k) offset[k + 1] = offset[k] + lens[k] + 1;
+        string_pool_init(&fresh);
+        arena = string_pool_alloc(&fresh, offset[count] + 1);
+    }
+
+    // Mesma divisão estática da cópia inicial das leituras: cada thread
+    // toca primeiro as páginas das strings que ela mesma varre
+    #pragma omp for schedule(static)
+    for (int k = 0; k < count; ++k) {
+        memcpy(arena + offset[k], strings[k], lens[k] + 1);
+        strings[k] = arena + offset[k];
+    }
+
+    #pragma omp single
+    {
+        string_pool_release(pool);
+        *pool = fresh;
+        free(offset);
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef READ_STORE_H
+#define READ_STORE_H
+
+#include <stddef.h>
+
+/**
+ * @brief Conjunto de leituras guardado numa única arena contígua.
+ * Cada leitura ocupa arena[offset[i] .. offset[i] + len[i]] e termina em
+ * '\0', de modo que pode ser usada diretamente como string C.
+ */
+typedef struct {
+    char* arena;
+    size_t size;
+    size_t capacity;
+    size_t* offset;
+    int* len;
+    int count;
+    int max_count;
+} read_store_t;
+
+/**
+ * @brief Inicializa um conjunto vazio.
+ * * @param store O conjunto.
+ * @param expected_count Número esperado de leituras (só para pré-alocação).
+ */
+void read_store_init(read_store_t* store, int expected_count);
+
+/**
+ * @brief Acrescenta uma leitura ao fim da arena.
+ * * @param store O conjunto.
+ * @param s Os bytes da leitura (não precisam terminar em '\0').
+ * @param len O comprimento da leitura.
+ */
+void read_store_add(read_store_t* store, const char* s, int len);
+
+/**
+ * @brief Ajusta o conjunto para exatamente 'count' leituras ocupando 'size'
+ * bytes da arena, sem preenchê-las: o chamador escreve arena, offset e len
+ * diretamente (usado pelo carregador paralelo).
+ */
+void read_store_resize(read_store_t* store, int count, size_t size);
+
+/**
+ * @brief Devolve a leitura i. O ponteiro só é válido até a próxima inserção.
+ */
+static inline char* read_store_get(const read_store_t* store, int i) {
+    return store->arena + store->offset[i];
+}
+
+/**
+ * @brief Libera toda a memória do conjunto.
+ */
+void read_store_free(read_store_t* store);
+
+/**
+ * @brief Bloco de um alocador bump.
+ */
+typedef struct pool_block {
+    struct pool_block* prev;
+    size_t used;
+    size_t capacity;
+    char data[];
+} pool_block_t;
+
+/**
+ * @brief Alocador bump para os contigs gerados pelas fusões: cada alocação
+ * apenas avança um ponteiro e toda a memória é devolvida de uma só vez
+ * por string_pool_release().
+ */
+typedef struct {
+    pool_block_t* top;
+    size_t bytes;       // total de bytes entregues desde a criação
+} string_pool_t;
+
+/**
+ * @brief Inicializa um pool vazio.
+ */
+void string_pool_init(string_pool_t* pool);
+
+/**
+ * @brief Reserva 'size' bytes no pool.
+ */
+char* string_pool_alloc(string_pool_t* pool, size_t size);
+
+/**
+ * @brief Devolve toda a memória do pool.
+ */
+void string_pool_release(string_pool_t* pool);
+
+/**
+ * @brief Copia as strings vivas para um pool novo e libera o antigo de uma
+ * só vez, para que o pool não cresça com contigs já descartados. Dentro de
+ * uma região paralela deve ser chamada por todas as threads do time, que
+ * dividem a cópia com schedule(static) (first touch); fora dela roda
+ * sequencialmente.
+ * * @param pool O pool; ao final passa a ser o pool novo.
+ * @param strings As strings vivas (os ponteiros passam a apontar para as cópias).
+ * @param lens O comprimento de cada string.
+ * @param count O número de strings.
+ */
+void string_pool_compact(string_pool_t* pool, char** strings, const int* lens, int count);
+
+#endif
@@ -14,7 +14,7 @@ NUM_RUNS=10
 # --- COMPILAÇÃO ---
 echo "Compilando o programa '$SOURCE_FILE'..."
 # Usamos -fopenmp para habilitar o OpenMP e -O3 para otimização de performance
-gcc -o "$EXECUTABLE" "$SOURCE_FILE" -mavx2 -fopenmp -O3
+gcc -o "$EXECUTABLE" "$SOURCE_FILE" overlap_ac.c read_filter.c read_loader.c read_store.c trace.c -fopenmp -O3
 
 # Verifica se a compilação foi bem-sucedida
 if [ $? -ne 0 ]; then
@@ -0,0 +1,124 @@
+#include "seed_index.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SEED_HASH_BASE 0x100000001b3ULL
+
+typedef struct {
+    uint64_t hash;
+    int read;
+} seed_entry_t;
+
+static void* checked_malloc(size_t size) {
+    void* p = malloc(size);
+    if (p == NULL && size > 0) {
+        perror("Falha ao alocar memória em seed_index_build");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+static uint64_t hash_kmer(const char* s, int k) {
+    uint64_t h = 0;
+    for (int i = 0; i < k; ++i) h = h * SEED_HASH_BASE + (unsigned char)s[i];
+    return h;
+}
+
+static int compare_entries(const void* x, const void* y) {
+    const seed_entry_t* a = x;
+    const seed_entry_t* b = y;
+    if (a->hash != b->hash) return a->hash < b->hash ? -1 : 1;
+    return (a->read > b->read) - (a->read < b->read);
+}
+
+void seed_index_build(seed_index_t* index, char** strings, const int* lens, int count, int k) {
+    index->k = k;
+    index->power = 1;
+    for (int i = 1; i < k; ++i) index->power *= SEED_HASH_BASE;
+
+    seed_entry_t* entries = checked_malloc((count + 1) * sizeof(seed_entry_t));
+    int num_entries = 0;
+    for (int i = 0; i < count; ++i) {
+        if (lens[i] < k) continue;
+        entries[num_entries].hash = hash_kmer(strings[i], k);
+        entries[num_entries].read = i;
+        num_entries++;
+    }
+    qsort(entries, num_entries, sizeof(seed_entry_t), compare_entries);
+
+    index->reads = checked_malloc((num_entries + 1) * sizeof(int));
+    index->group_start = checked_malloc((num_entries + 1) * sizeof(int));
+    index->group_hash = checked_malloc((num_entries + 1) * sizeof(uint64_t));
+    index->num_groups = 0;
+    for (int e = 0; e < num_entries; ++e) {
+        if (e == 0 || entries[e].hash != entries[e - 1].hash) {
+            index->group_start[index->num_groups] = e;
+            index->group_hash[index->num_groups] = entries[e].hash;
+            index->num_groups++;
+        }
+        index->reads[e] = entries[e].read;
+    }
+    index->group_start[index->num_groups] = num_entries;
+    free(entries);
+
+    size_t capacity = 16;
+    while (capacity < 2 * (size_t)index->num_groups) capacity *= 2;
+    index->table = checked_malloc(capacity * sizeof(int));
+    memset(index->table, -1, capacity * sizeof(int));
+    index->table_mask = capacity - 1;
+    for (int g = 0; g < index->num_groups; ++g) {
+        uint64_t slot = (index->group_hash[g] * 0x9E3779B97F4A7C15ULL >> 32) & index->table_mask;
+        while (index->table[slot] >= 0) slot = (slot + 1) & index->table_mask;
+        index->table[slot] = g;
+    }
+}
+
+static int find_group(const seed_index_t* index, uint64_t hash) {
+    uint64_t slot = (hash * 0x9E3779B97F4A7C15ULL >> 32) & index->table_mask;
+    while (index->table[slot] >= 0) {
+        int g = index->table[slot];
+        if (index->group_hash[g] == hash) return g;
+        slot = (slot + 1) & index->table_mask;
+    }
+    return -1;
+}
+
+int seed_index_overlaps(const seed_index_t* index, char** strings, const int* lens, int a, int* out, int* seen) {
+    int k = index->k;
+    int len_a = lens[a];
+    if (len_a < k || index->num_groups == 0) return 0;
+
+    const unsigned char* s = (const unsigned char*)strings[a];
+    uint64_t h = hash_kmer(strings[a], k);
+    int m = 0;
+
+    // Posições em ordem crescente: a primeira ocorrência de cada destino
+    // é a maior sobreposição com ele
+    for (int p = 0; p + k <= len_a; ++p) {
+        if (p > 0) h = (h - s[p - 1] * index->power) * SEED_HASH_BASE + s[p + k - 1];
+
+        int g = find_group(index, h);
+        if (g < 0) continue;
+
+        int overlap = len_a - p;
+        for (int e = index->group_start[g]; e < index->group_start[g + 1]; ++e) {
+            int b = index->reads[e];
+            if (b == a || seen[b] == a || overlap > lens[b]) continue;
+            if (memcmp(strings[a] + p, strings[b], overlap) != 0) continue;
+            seen[b] = a;
+            out[2 * m] = b;
+            out[2 * m + 1] = overlap;
+            m++;
+        }
+    }
+    return m;
+}
+
+void seed_index_free(seed_index_t* index) {
+    free(index->reads);
+    free(index->group_start);
+    free(index->group_hash);
+    free(index->table);
+}
@@ -0,0 +1,54 @@
+#ifndef SEED_INDEX_H
+#define SEED_INDEX_H
+
+#include <stdint.h>
+
+/**
+ * @brief Índice das sementes de prefixo: os k primeiros caracteres de cada
+ * leitura com pelo menos k caracteres. Toda sobreposição de comprimento
+ * >= k de 'a' em 'b' começa numa posição de 'a' onde aparece a semente de
+ * 'b', então basta procurar cada k-mer de 'a' no índice para achar todos
+ * os candidatos, sem a varredura n×n.
+ */
+typedef struct {
+    int k;
+    int num_groups;
+    int* reads;             // leituras agrupadas pela semente
+    int* group_start;       // grupo g = reads[group_start[g] .. group_start[g + 1])
+    uint64_t* group_hash;
+    int* table;             // endereçamento aberto: hash -> grupo (-1 = vazio)
+    uint64_t table_mask;
+    uint64_t power;         // base^(k - 1), para o hash deslizante
+} seed_index_t;
+
+/**
+ * @brief Constrói o índice.
+ * * @param index O índice.
+ * @param strings As leituras.
+ * @param lens O comprimento de cada leitura.
+ * @param count O número de leituras.
+ * @param k Comprimento das sementes (a sobreposição mínima).
+ */
+void seed_index_build(seed_index_t* index, char** strings, const int* lens, int count, int k);
+
+/**
+ * @brief Todas as sobreposições de comprimento >= k da leitura 'a' com as
+ * outras leituras, com o mesmo valor que calculate_overlap daria.
+ * * @param index O índice.
+ * @param strings As leituras.
+ * @param lens O comprimento de cada leitura.
+ * @param a A leitura de origem.
+ * @param out Recebe os pares (destino, sobreposição), em ordem arbitrária.
+ * Precisa de espaço para 2 × count inteiros.
+ * @param seen Vetor de rascunho de 'count' inteiros da thread, iniciado
+ * com -1 e reaproveitado entre chamadas.
+ * @return O número de pares.
+ */
+int seed_index_overlaps(const seed_index_t* index, char** strings, const int* lens, int a, int* out, int* seen);
+
+/**
+ * @brief Libera o índice.
+ */
+void seed_index_free(seed_index_t* index);
+
+#endif
@@ -5,15 +5,31 @@
 #include <limits.h>
 #include <omp.h>
 
+#include "overlap_ac.h"
+#include "read_filter.h"
+#include "read_loader.h"
+#include "read_store.h"
+#include "trace.h"
+
+/**
+ * @brief Backends de cálculo de sobreposição.
+ * OVERLAP_PAIR compara cada par com calculate_overlap;
+ * OVERLAP_AC calcula a matriz de todos os pares com um autômato de Aho-Corasick.
+ */
+typedef enum {
+    OVERLAP_PAIR,
+    OVERLAP_AC
+} overlap_backend_t;
+
 /**
  * @brief Calcula o comprimento do maior sufixo de 'a' que é também um prefixo de 'b'.
  * * @param a A primeira string.
+ * @param len_a O comprimento de 'a'.
  * @param b A segunda string.
+ * @param len_b O comprimento de 'b'.
  * @return O comprimento da sobreposição.
  */
-int calculate_overlap(const char* a, const char* b) {
-    int len_a = strlen(a);
-    int len_b = strlen(b);
+int calculate_overlap(const char* a, int len_a, const char* b, int len_b) {
     int max_overlap = 0;
 
     for (int i = 1; i <= len_a && i <= len_b; ++i) {
@@ -28,20 +44,17 @@ int calculate_overlap(const char* a, const char* b) {
 /**
  * @brief Mescla duas strings com base em sua sobreposição.
  * * @param a A primeira string.
+ * @param len_a O comprimento de 'a'.
  * @param b A segunda string.
+ * @param len_b O comprimento de 'b'.
  * @param overlap_len O comprimento da sobreposição (sufixo de 'a' e prefixo de 'b').
- * @return Uma nova string alocada contendo a fusão. O chamador deve liberá-la.
+ * @param pool Pool de onde a nova string é alocada; ela vive até o pool ser liberado.
+ * @return A fusão, com comprimento len_a + len_b - overlap_len.
  */
-char* merge_strings(const char* a, const char* b, int overlap_len) {
-    int len_a = strlen(a);
-    int len_b = strlen(b);
+char* merge_strings(const char* a, int len_a, const char* b, int len_b, int overlap_len, string_pool_t* pool) {
     int new_len = len_a + len_b - overlap_len;
 
-    char* result = (char*)malloc(new_len + 1);
-    if (result == NULL) {
-        perror("Falha ao alocar memória em merge_strings");
-        exit(EXIT_FAILURE);
-    }
+    char* result = string_pool_alloc(pool, new_len + 1);
 
     memcpy(result, a, len_a);
     memcpy(result + len_a, b + overlap_len, len_b - overlap_len);
@@ -54,23 +67,42 @@ char* merge_strings(const char* a, const char* b, int overlap_len) {
 /**
  * @brief Encontra a superstring mais curta para um conjunto de strings.
  * * @param strings Um array de strings.
+ * @param lens O comprimento de cada string (rearranjado junto com 'strings').
  * @param count O número de strings no array.
+ * @param backend Como as sobreposições são calculadas.
  * @return A superstring mais curta. O chamador deve liberar a memória.
  */
-char* shortest_superstring(char** strings, int* count) {
+char* shortest_superstring(char** strings, int* lens, int* count, overlap_backend_t backend) {
     double parallelable_time_total = 0.0;
 
+    // Contigs gerados pelas fusões; 'live_bytes' é o tamanho somado das strings vivas
+    string_pool_t pool;
+    string_pool_init(&pool);
+    size_t live_bytes = 0;
+    for (int k = 0; k < *count; ++k) live_bytes += lens[k] + 1;
+
     while (*count > 1) {
         int max_overlap = -1;
         int best_i = -1, best_j = -1;
 
         double start_parallelable_time_local = omp_get_wtime();
+
+        int* overlaps = NULL;
+        if (backend == OVERLAP_AC) {
+            TRACE_BEGIN(PHASE_OVERLAP);
+            overlaps = overlap_matrix_ac(strings, lens, *count, false);
+            TRACE_END(PHASE_OVERLAP);
+        }
+        TRACE_BEGIN(PHASE_SELECTION);
+
         // Encontra o par de strings com a maior sobreposição
         for (int i = 0; i < *count; ++i) {
             for (int j = 0; j < *count; ++j) {
                 if (i == j) continue;
 
-                int current_overlap = calculate_overlap(strings[i], strings[j]);
+                int current_overlap = overlaps
+                    ? overlaps[(size_t)i * *count + j]
+                    : calculate_overlap(strings[i], lens[i], strings[j], lens[j]);
 
                 // --- MODIFICAÇÃO PRINCIPAL INICIA AQUI ---
                 // A condição para atualizar o melhor par foi expandida.
@@ -104,6 +136,10 @@ char* shortest_superstring(char** strings, int* count) {
             }
         }
 
+        free(overlaps);
+        TRACE_END(PHASE_SELECTION);
+        TRACE_ITERATION((long long)*count * (*count - 1), max_overlap, *count);
+
         double end_parallelable_time_local = omp_get_wtime();
         parallelable_time_total += end_parallelable_time_local - start_parallelable_time_local;
         // Se não houver sobreposição, mescla os dois primeiros para evitar loop infinito
@@ -116,86 +152,152 @@ char* shortest_superstring(char** strings, int* count) {
         }
 
         // Mescla o melhor par encontrado
-        char* merged = merge_strings(strings[best_i], strings[best_j], max_overlap);
+        TRACE_BEGIN(PHASE_MERGE);
+        int merged_len = lens[best_i] + lens[best_j] - max_overlap;
+        char* merged = merge_strings(strings[best_i], lens[best_i], strings[best_j], lens[best_j],
+                                     max_overlap, &pool);
         
         // --- LÓGICA DE REMOÇÃO CORRIGIDA E ROBUSTA ---
         // Para evitar bugs, sempre lidamos com os índices em ordem.
         int idx_to_replace = (best_i < best_j) ? best_i : best_j;
         int idx_to_remove = (best_i > best_j) ? best_i : best_j;
 
-        // Libera a memória das strings que foram mescladas
-        free(strings[best_i]);
-        free(strings[best_j]);
-
-        // Substitui a string no índice menor pela nova string mesclada
+        // Substitui a string no índice menor pela nova string mesclada;
+        // as strings antigas ficam no pool até a próxima compactação
         strings[idx_to_replace] = merged;
+        lens[idx_to_replace] = merged_len;
+        live_bytes -= max_overlap + 1;
 
         start_parallelable_time_local = omp_get_wtime();
         // Remove a string do índice maior, deslocando os elementos restantes para a esquerda
         for (int k = idx_to_remove; k < *count - 1; ++k) {
             strings[k] = strings[k + 1];
+            lens[k] = lens[k + 1];
         }
         end_parallelable_time_local = omp_get_wtime();
         parallelable_time_total += end_parallelable_time_local - start_parallelable_time_local;
         
         (*count)--;
+        TRACE_END(PHASE_MERGE);
+
+        // O pool só cresce; quando passa do dobro do que está vivo, é compactado
+        if (pool.bytes > 2 * live_bytes + (1 << 20)) {
+            TRACE_BEGIN(PHASE_COMPACTION);
+            string_pool_compact(&pool, strings, lens, *count);
+            TRACE_END(PHASE_COMPACTION);
+        }
     }
 
     fprintf(stderr, "Tempo total das regiões paralelizáveis: %.6f segundos\n", parallelable_time_total);
     // Retorna uma cópia da única string restante
-    return strdup(strings[0]);
+    char* result = strdup(strings[0]);
+    strings[0] = NULL;
+    string_pool_release(&pool);
+    return result;
+}
+
+/**
+ * @brief Lê as opções de linha de comando.
+ * * @param argc Número de argumentos.
+ * @param argv Os argumentos.
+ * @param backend Backend de sobreposição escolhido.
+ * @param input_path Arquivo de entrada (NULL = entrada padrão).
+ * @param filter Se deve remover leituras repetidas e contidas antes da fase gulosa.
+ * @param trace_prefix Prefixo dos arquivos de rastreamento (NULL = desligado).
+ * @return true se todas as opções foram reconhecidas.
+ */
+bool parse_options(int argc, char** argv, overlap_backend_t* backend, const char** input_path, bool* filter,
+                   const char** trace_prefix) {
+    *backend = OVERLAP_PAIR;
+    *input_path = NULL;
+    *filter = false;
+    *trace_prefix = NULL;
+
+    for (int a = 1; a < argc; ++a) {
+        if (strcmp(argv[a], "--overlap=pair") == 0) {
+            *backend = OVERLAP_PAIR;
+        } else if (strcmp(argv[a], "--overlap=ac") == 0) {
+            *backend = OVERLAP_AC;
+        } else if (strcmp(argv[a], "--filter") == 0) {
+            *filter = true;
+        } else if (strncmp(argv[a], "--trace=", 8) == 0 && argv[a][8] != '\0') {
+            *trace_prefix = argv[a] + 8;
+        } else if (argv[a][0] != '-' && *input_path == NULL) {
+            *input_path = argv[a];
+        } else {
+            fprintf(stderr, "Opção desconhecida: %s\n", argv[a]);
+            fprintf(stderr, "Uso: %s [--overlap=pair|ac] [--filter] [--trace=PREFIXO] [entrada]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
 }
 
-int main() {
+int main(int argc, char** argv) {
     int n;
+    overlap_backend_t backend;
+    const char* input_path;
+    bool filter;
+    const char* trace_prefix;
     double start_time_global = omp_get_wtime();
-    if (scanf("%d", &n) != 1 || n < 0) {
-        fprintf(stderr, "Entrada inválida para o número de strings.\n");
+
+    if (!parse_options(argc, argv, &backend, &input_path, &filter, &trace_prefix)) {
         return 1;
     }
-    
-    // Aloca um array de ponteiros para as strings
-    char** strings = (char**)malloc(n * sizeof(char*));
-    if (strings == NULL && n > 0) {
-        perror("Falha ao alocar memória para o array de strings");
-        return 1;
+    if (trace_prefix != NULL) {
+        trace_open(trace_prefix);
     }
 
-    // Buffer temporário para ler cada string
-    char buffer[1024]; 
-    for (int i = 0; i < n; ++i) {
-        if (scanf("%1023s", buffer) != 1) {
-            fprintf(stderr, "Erro ao ler a string %d.\n", i + 1);
-            // Libera memória já alocada antes de sair
-            for (int j = 0; j < i; ++j) {
-                free(strings[j]);
-            }
-            free(strings);
-            return 1;
-        }
-        strings[i] = strdup(buffer);
+    // Todas as leituras ficam numa única arena contígua; sem arquivo na
+    // linha de comando, lê da entrada padrão
+    read_store_t store;
+    TRACE_BEGIN(PHASE_PARSE);
+    if (!read_loader_load(input_path, &store, NULL)) {
+        return 1;
     }
-    
+    TRACE_END(PHASE_PARSE);
+    n = store.count;
+
     if (n == 0) {
         printf("\n");
-        free(strings);
+        read_store_free(&store);
         return 0;
     }
 
+    // Visões das leituras: ponteiros para a arena e comprimentos em cache
+    char** strings = (char**)malloc(n * sizeof(char*));
+    int* lens = (int*)malloc(n * sizeof(int));
+    if (strings == NULL || lens == NULL) {
+        perror("Falha ao alocar memória para o array de strings");
+        return 1;
+    }
+    for (int i = 0; i < n; ++i) {
+        strings[i] = read_store_get(&store, i);
+        lens[i] = store.len[i];
+    }
+
+    // Leituras repetidas ou contidas em outra não mudam a superstring
     int string_count = n;
-    char* result = shortest_superstring(strings, &string_count);
+    if (filter) {
+        read_filter_stats_t stats;
+        string_count = read_filter_apply(strings, lens, n, false, &stats);
+        fprintf(stderr, "Pré-filtro: %d repetidas e %d contidas removidas (%d -> %d leituras)\n",
+                stats.duplicates, stats.contained, n, string_count);
+    }
+
+    char* result = shortest_superstring(strings, lens, &string_count, backend);
 
     printf("%s\n", result);
 
     // Libera toda a memória alocada
     free(result);
-    for (int i = 0; i < string_count; ++i) {
-        free(strings[i]);
-    }
     free(strings);
+    free(lens);
+    read_store_free(&store);
+    trace_close();
 
     double end_time_global = omp_get_wtime();
     fprintf(stderr, "Tempo de execução total: %.6f segundos\n", end_time_global - start_time_global);
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,218 @@
+#ifndef SHORTEST_SUPERSTRING_HH
+#define SHORTEST_SUPERSTRING_HH
+
+// Resolvedor guloso da menor superstring, só cabeçalho.
+//
+// Mesma semântica da versão original com Set <String>:
+//   - leituras repetidas contam uma vez só;
+//   - a sobreposição de (s, t) é o maior sufixo próprio de s (k < |s|)
+//     que é prefixo de t (k <= |t|);
+//   - a cada passo funde o par de maior sobreposição; empates ficam com o
+//     menor par (s, t) em ordem lexicográfica;
+//   - a fusão é s + t [k ..], exceto quando k == |t|, em que t inteira é
+//     anexada (comportamento de remove_prefix);
+//   - se a fusão for igual a uma string já presente, as duas viram uma só.
+//
+// As strings vivem em "slots" indexados por inteiros; a matriz de
+// sobreposições entre slots é calculada uma vez com a função de prefixo
+// (KMP) e atualizada só na linha e na coluna do slot novo a cada fusão.
+// Cada linha guarda o seu melhor destino, de modo que achar o melhor par
+// custa O(n) por passo em vez de O(n²) cópias de pares de strings.
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace shsup {
+
+using Size = std::size_t ;
+
+template <typename C>
+using StringOf = std::basic_string <C> ;
+
+template <typename C>
+using ViewOf = std::basic_string_view <C> ;
+
+template <typename T>
+using Vector = std::vector <T> ;
+
+// pi [q] = comprimento da maior borda própria de s [0 .. q]
+template <typename C> auto
+prefix_function (ViewOf <C> s) -> Vector <int>
+{
+    Vector <int> pi (s.size ()) ;
+    int q = 0 ;
+    for (Size i = 1 ; i < s.size () ; ++ i) {
+        while (q > 0 && s [i] != s [q]) q = pi [q - 1] ;
+        if (s [i] == s [q]) ++ q ;
+        pi [i] = q ;
+    }
+    return pi ;
+}
+
+// Maior k < |a|, k <= |b| com sufixo de a == prefixo de b, em O(|b|):
+// percorre com o autômato KMP de b só os últimos min (|a| - 1, |b|)
+// caracteres de a.
+template <typename C> auto
+overlap_value (ViewOf <C> a, ViewOf <C> b, const Vector <int>& pi_b) -> int
+{
+    if (a.size () < 2 || b.empty ()) return 0 ;
+    int limit = int (std::min (a.size () - 1, b.size ())) ;
+    int q = 0 ;
+    for (C c : a.substr (a.size () - limit)) {
+        while (q > 0 && (q == limit || b [q] != c)) q = pi_b [q - 1] ;
+        if (b [q] == c) ++ q ;
+    }
+    return q ;
+}
+
+template <typename C> auto
+merge (ViewOf <C> a, ViewOf <C> b, int k) -> StringOf <C>
+{
+    StringOf <C> m ;
+    ViewOf <C> tail = Size (k) < b.size () ? b.substr (k) : b ;
+    m.reserve (a.size () + tail.size ()) ;
+    m.append (a) ;
+    m.append (tail) ;
+    return m ;
+}
+
+template <typename C>
+class GreedySolver
+{
+public :
+    explicit GreedySolver (Vector <StringOf <C>> reads)
+    {
+        std::sort (reads.begin (), reads.end ()) ;
+        reads.erase (std::unique (reads.begin (), reads.end ()), reads.end ()) ;
+
+        n_ = reads.size () ;
+        slots_.resize (n_) ;
+        overlaps_.assign (n_ * n_, 0) ;
+        for (Size a = 0 ; a < n_ ; ++ a) {
+            slots_ [a].text = std::move (reads [a]) ;
+            slots_ [a].pi = prefix_function <C> (slots_ [a].text) ;
+            index_.emplace (view (a), int (a)) ;
+            live_.push_back (int (a)) ;
+        }
+        for (int a : live_) {
+            for (int b : live_) {
+                if (a != b) at (a, b) = overlap_value <C> (view (a), view (b), slots_ [b].pi) ;
+            }
+        }
+        for (int a : live_) rescan (a) ;
+    }
+
+    auto run () -> StringOf <C>
+    {
+        if (live_.empty ()) return StringOf <C> () ;
+        while (live_.size () > 1) step () ;
+        return std::move (slots_ [live_ [0]].text) ;
+    }
+
+private :
+    struct Slot
+    {
+        StringOf <C> text ;
+        Vector <int> pi ;
+        int best    = -1 ;  // melhor destino da linha
+        int best_ov = -1 ;
+    } ;
+
+    Size n_ ;
+    Vector <Slot> slots_ ;
+    Vector <int> overlaps_ ;
+    Vector <int> live_ ;
+    std::unordered_map <ViewOf <C>, int> index_ ;
+
+    auto view (int a) const -> ViewOf <C> { return slots_ [a].text ; }
+    auto at (int a, int b) -> int& { return overlaps_ [Size (a) * n_ + b] ; }
+
+    // (ov, b) é melhor destino que o atual da linha a?
+    auto improves (int a, int ov, int b) const -> bool
+    {
+        const Slot& s = slots_ [a] ;
+        return ov > s.best_ov
+            || (ov == s.best_ov && view (b) < view (s.best)) ;
+    }
+
+    auto rescan (int a) -> void
+    {
+        Slot& s = slots_ [a] ;
+        s.best = -1 ;
+        s.best_ov = -1 ;
+        for (int b : live_) {
+            if (b != a && improves (a, at (a, b), b)) {
+                s.best = b ;
+                s.best_ov = at (a, b) ;
+            }
+        }
+    }
+
+    auto remove_live (int a) -> void
+    {
+        index_.erase (view (a)) ;
+        live_.erase (std::find (live_.begin (), live_.end (), a)) ;
+    }
+
+    auto step () -> void
+    {
+        int a = -1 ;
+        for (int x : live_) {
+            const Slot& s = slots_ [x] ;
+            if (a < 0
+                    || s.best_ov > slots_ [a].best_ov
+                    || (s.best_ov == slots_ [a].best_ov && view (x) < view (a)))
+                a = x ;
+        }
+        int b = slots_ [a].best ;
+
+        StringOf <C> m = merge <C> (view (a), view (b), slots_ [a].best_ov) ;
+        remove_live (a) ;
+        remove_live (b) ;
+
+        // A fusão reaproveita o slot de a, a menos que já exista
+        int fresh = -1 ;
+        if (index_.find (ViewOf <C> (m)) == index_.end ()) {
+            fresh = a ;
+            Slot& s = slots_ [fresh] ;
+            s.text = std::move (m) ;
+            s.pi = prefix_function <C> (s.text) ;
+            index_.emplace (view (fresh), fresh) ;
+            for (int x : live_) {
+                at (fresh, x) = overlap_value <C> (view (fresh), view (x), slots_ [x].pi) ;
+                at (x, fresh) = overlap_value <C> (view (x), view (fresh), s.pi) ;
+            }
+            live_.push_back (fresh) ;
+        }
+        slots_ [b].text = StringOf <C> () ;
+        slots_ [b].pi = Vector <int> () ;
+
+        for (int x : live_) {
+            if (x == fresh) continue ;
+            Slot& s = slots_ [x] ;
+            if (s.best == a || s.best == b) {
+                rescan (x) ;
+            } else if (fresh >= 0 && improves (x, at (x, fresh), fresh)) {
+                s.best = fresh ;
+                s.best_ov = at (x, fresh) ;
+            }
+        }
+        if (fresh >= 0) rescan (fresh) ;
+    }
+} ;
+
+// Menor superstring gulosa das leituras (repetidas contam uma vez).
+template <typename C> auto
+shortest_superstring (Vector <StringOf <C>> reads) -> StringOf <C>
+{
+    return GreedySolver <C> (std::move (reads)).run () ;
+}
+
+} // namespace shsup
+
+#endif
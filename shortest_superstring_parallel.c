@@ -3,247 +3,612 @@
 #include <string.h>
 #include <stdbool.h>
 #include <omp.h>
-#include <limits.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "checkpoint.h"
+#include "exact_superstring.h"
+#include "read_filter.h"
+#include "read_loader.h"
+#include "read_store.h"
+#include "superstring.h"
+#include "trace.h"
+
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
 
 //#define NUM_THREADS 8
 
 /**
- * @brief Calcula o comprimento do maior sufixo de 'a' que é também um prefixo de 'b'.
- * * @param a A primeira string.
- * @param b A segunda string.
- * @return O comprimento da sobreposição.
+ * @brief Opções de linha de comando: as das engines (superstring.h) e as
+ * do executável.
  */
-int calculate_overlap_simd(const char* a, const char* b) {
-    int len_a = strlen(a);
-    int len_b = strlen(b);
-    int max_overlap = 0;
-    int min_length = (len_a < len_b) ? len_a : len_b;
-
-    // Itera do maior overlap possível para o menor
-    for (int i = min_length; i > 0; --i) {
-        const char* suffix_a = a + len_a - i;
-        const char* prefix_b = b;
-
-        bool is_match = true;
-
-        // Pedimos ao compilador para vetorizar este loop de comparação.
-        // A cláusula `reduction` garante que a variável `is_match`
-        // seja tratada corretamente pelas threads SIMD.
-        #pragma omp simd reduction(&:is_match)
-        for (int k = 0; k < i; ++k) {
-            is_match = is_match && (suffix_a[k] == prefix_b[k]);
-        }
-        
-        // Se encontramos uma correspondência, este é o maior overlap possível.
-        // Podemos parar e retornar o valor imediatamente.
-        if (is_match) {
-            max_overlap = i;
-            break; // Otimização: sair cedo, já que encontramos o maior.
-        }
-    }
-    return max_overlap;
-}
+typedef struct {
+    solver_options_t solver;
+    bool exact;         // superstring ótima por Held–Karp (poucas leituras)
+    bool filter;        // remove leituras repetidas e contidas antes da fase gulosa
+    const char* trace;  // prefixo dos arquivos de rastreamento (trace.h); NULL = desligado
+    bool resume;                // retoma a partir de 'solver.checkpoint'
+    const char* batch;          // lista de arquivos ou diretório (modo lote); NULL = uma instância
+    const char* output_dir;     // onde o modo lote grava as saídas (NULL = ao lado da entrada)
+} options_t;
 
 /**
- * @brief Mescla duas strings com base em sua sobreposição.
- * * @param a A primeira string.
- * @param b A segunda string.
- * @param overlap_len O comprimento da sobreposição (sufixo de 'a' e prefixo de 'b').
- * @return Uma nova string alocada contendo a fusão. O chamador deve liberá-la.
+ * @brief Entradas a partir deste tamanho usam o time inteiro no modo lote;
+ * as menores são resolvidas uma por thread.
  */
-char* merge_strings(const char* a, const char* b, int overlap_len) {
-    int len_a = strlen(a);
-    int len_b = strlen(b);
-    int new_len = len_a + len_b - overlap_len;
+#define BATCH_LARGE_BYTES 4096
 
-    char* result = (char*)malloc(new_len + 1);
-    if (result == NULL) {
-        perror("Falha ao alocar memória em merge_strings");
-        exit(EXIT_FAILURE);
+// Só o processo 0 lê a entrada e imprime
+static int mpi_rank = 0;
+static int mpi_size = 1;
+
+#ifdef USE_MPI
+/**
+ * @brief Envia as leituras lidas pelo processo 0 para todos os processos.
+ * * @param store O conjunto; nos processos diferentes de 0 é preenchido aqui.
+ * @param n Número de leituras (já conhecido por todos).
+ */
+static void broadcast_store(read_store_t* store, int n) {
+    unsigned long long size = store->size;
+    MPI_Bcast(&size, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+
+    if (mpi_rank == 0) {
+        MPI_Bcast(store->arena, (int)size, MPI_CHAR, 0, MPI_COMM_WORLD);
+        MPI_Bcast(store->len, n, MPI_INT, 0, MPI_COMM_WORLD);
+        return;
     }
 
-    // Copia string a para result
-    memcpy(result, a, len_a);
-    memcpy(result + len_a, b + overlap_len, len_b - overlap_len);
-    result[new_len] = '\0';
+    // A arena do processo 0 já tem os '\0' separadores: basta reinseri-las
+    char* arena = malloc(size + 1);
+    int* len = malloc((n + 1) * sizeof(int));
+    MPI_Bcast(arena, (int)size, MPI_CHAR, 0, MPI_COMM_WORLD);
+    MPI_Bcast(len, n, MPI_INT, 0, MPI_COMM_WORLD);
 
-    return result;
+    size_t offset = 0;
+    for (int i = 0; i < n; ++i) {
+        read_store_add(store, arena + offset, len[i]);
+        offset += len[i] + 1;
+    }
+    free(arena);
+    free(len);
 }
+#endif
 
 /**
- * @brief Mescla duas strings com base em sua sobreposição.
- * * @param a A primeira string.
- * @param b A segunda string.
- * @param overlap_len O comprimento da sobreposição (sufixo de 'a' e prefixo de 'b').
- * @return Uma nova string alocada contendo a fusão. O chamador deve liberá-la.
+ * @brief Carrega o ponto de controle e confere se ele partiu das mesmas
+ * leituras (depois do pré-filtro) que esta execução.
+ * * @param path O arquivo do ponto de controle.
+ * @param history Histórico desta execução; é trocado pelo histórico salvo.
+ * @param contigs Recebe os contigs vivos.
+ * @return O número de contigs vivos, ou -1 em caso de erro.
  */
-char* shortest_superstring(char** strings, int* count) {
-    double parallel_time_total = 0.0;  // acumulador do tempo paralelo
-
-    while (*count > 1) {
-        int i, j;
-        int max_overlap = -1;
-        int best_i = -1, best_j = -1;
-
-        // --- BLOCO PARALELO 1: encontrar melhor par ---
-        double t_start = omp_get_wtime();
-
-        #pragma omp parallel
-        {
-            int local_max_overlap = -1;
-            int local_best_i = -1, local_best_j = -1;
-
-            #pragma omp for collapse(2) schedule(guided) nowait
-            for (i = 0; i < *count; ++i) {
-                for (j = 0; j < *count; ++j) {
-                    if (i != j) {
-                        int current_overlap = calculate_overlap_simd(strings[i], strings[j]);
-
-                        bool is_better = false;
-                        if (current_overlap > local_max_overlap) {
-                            is_better = true;
-                        } else if (current_overlap == local_max_overlap && local_max_overlap != -1) {
-                            int cmp1 = strcmp(strings[i], strings[local_best_i]);
-                            if (cmp1 < 0) {
-                                is_better = true;
-                            } else if (cmp1 == 0) {
-                                int cmp2 = strcmp(strings[j], strings[local_best_j]);
-                                if (cmp2 < 0) {
-                                    is_better = true;
-                                }
-                            }
-                        }
-
-                        if (is_better) {
-                            local_max_overlap = current_overlap;
-                            local_best_i = i;
-                            local_best_j = j;
-                        }
-                    }
-                }
-            }
-
-            #pragma omp critical
-            {
-                if (local_max_overlap > max_overlap) {
-                    max_overlap = local_max_overlap;
-                    best_i = local_best_i;
-                    best_j = local_best_j;
-                } else if (local_max_overlap == max_overlap && local_max_overlap != -1) {
-                    int cmp1 = strcmp(strings[local_best_i], strings[best_i]);
-                    if (cmp1 < 0) {
-                        best_i = local_best_i;
-                        best_j = local_best_j;
-                    } else if (cmp1 == 0) {
-                        int cmp2 = strcmp(strings[local_best_j], strings[best_j]);
-                        if (cmp2 < 0) {
-                            best_i = local_best_i;
-                            best_j = local_best_j;
-                        }
-                    }
-                }
-            }
-        }
+static int resume_from_checkpoint(const char* path, merge_history_t* history, read_store_t* contigs) {
+    merge_history_t saved;
+    if (!checkpoint_load(path, &saved, contigs)) return -1;
+
+    if (saved.input_hash != history->input_hash || saved.input_count != history->input_count) {
+        fprintf(stderr, "%s: o ponto de controle não corresponde a esta entrada\n", path);
+        merge_history_free(&saved);
+        read_store_free(contigs);
+        return -1;
+    }
+    merge_history_free(history);
+    *history = saved;
+    fprintf(stderr, "Retomando de %s: %d fusões já feitas, %d contigs vivos\n",
+            path, history->num_merges, contigs->count);
+    return contigs->count;
+}
 
-        double t_end = omp_get_wtime();
-        parallel_time_total += (t_end - t_start);
-        // --- FIM BLOCO PARALELO 1 ---
+/**
+ * @brief Uma instância do modo lote.
+ */
+typedef struct {
+    char* path;
+    off_t size;
+} batch_job_t;
+
+static int compare_jobs_by_size(const void* x, const void* y) {
+    const batch_job_t* a = x;
+    const batch_job_t* b = y;
+    if (a->size != b->size) return a->size < b->size ? 1 : -1;
+    return strcmp(a->path, b->path);
+}
 
-        if (best_i == -1) {
-             best_i = 0;
-             best_j = 1;
-             max_overlap = 0;
+/**
+ * @brief Acrescenta 'path' às instâncias se for um arquivo regular legível.
+ * * @param listed Verdadeiro se o caminho veio de uma lista: aí uma entrada
+ * ausente, ilegível ou que não é arquivo é um erro e é relatada; num
+ * diretório, o que não é arquivo regular é só pulado.
+ * @return false se a entrada não foi acrescentada.
+ */
+static bool add_batch_job(batch_job_t** jobs, int* count, int* capacity, const char* path, bool listed) {
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        if (listed) perror(path);
+        return false;
+    }
+    if (!S_ISREG(st.st_mode)) {
+        if (listed) fprintf(stderr, "%s: não é um arquivo\n", path);
+        return false;
+    }
+    if (listed && access(path, R_OK) != 0) {
+        perror(path);
+        return false;
+    }
+    if (*count == *capacity) {
+        *capacity = *capacity ? 2 * *capacity : 64;
+        *jobs = realloc(*jobs, *capacity * sizeof(batch_job_t));
+    }
+    (*jobs)[*count].path = strdup(path);
+    (*jobs)[*count].size = st.st_size;
+    (*count)++;
+    return true;
+}
+
+/**
+ * @brief Lista as entradas do modo lote: os arquivos de um diretório (sem
+ * os ocultos e as saídas '.out') ou os caminhos de uma lista, um por linha (linhas vazias e
+ * começadas por '#' são ignoradas). As maiores ficam primeiro.
+ * * @param source O diretório ou a lista.
+ * @param jobs Recebe as instâncias.
+ * @param bad Recebe o número de entradas da lista que não puderam ser usadas.
+ * @return O número de instâncias, ou -1 se 'source' não pôde ser lido.
+ */
+static int collect_batch_jobs(const char* source, batch_job_t** jobs, int* bad) {
+    int count = 0, capacity = 0;
+    *jobs = NULL;
+    *bad = 0;
+
+    struct stat st;
+    if (stat(source, &st) == 0 && S_ISDIR(st.st_mode)) {
+        DIR* dir = opendir(source);
+        if (dir == NULL) {
+            perror(source);
+            return -1;
+        }
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != NULL) {
+            size_t name_len = strlen(entry->d_name);
+            if (entry->d_name[0] == '.') continue;
+            if (name_len > 4 && strcmp(entry->d_name + name_len - 4, ".out") == 0) continue;  // saídas anteriores
+            size_t size = strlen(source) + strlen(entry->d_name) + 2;
+            char* path = malloc(size);
+            snprintf(path, size, "%s/%s", source, entry->d_name);
+            add_batch_job(jobs, &count, &capacity, path, false);
+            free(path);
         }
+        closedir(dir);
+    } else {
+        FILE* list = fopen(source, "r");
+        if (list == NULL) {
+            perror(source);
+            return -1;
+        }
+        char* line = NULL;
+        size_t line_capacity = 0;
+        ssize_t len;
+        while ((len = getline(&line, &line_capacity, list)) != -1) {
+            while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r' || line[len - 1] == ' ')) line[--len] = '\0';
+            if (len == 0 || line[0] == '#') continue;
+            if (!add_batch_job(jobs, &count, &capacity, line, true)) (*bad)++;
+        }
+        free(line);
+        fclose(list);
+    }
 
-        char* merged = merge_strings(strings[best_i], strings[best_j], max_overlap);
-        
-        int idx_to_replace = (best_i < best_j) ? best_i : best_j;
-        int idx_to_remove = (best_i > best_j) ? best_i : best_j;
+    qsort(*jobs, count, sizeof(batch_job_t), compare_jobs_by_size);
+    return count;
+}
 
-        free(strings[best_i]);
-        free(strings[best_j]);
+/**
+ * @brief Resolve uma instância do modo lote e grava a superstring no seu
+ * arquivo de saída. Chamada por uma thread sozinha (instâncias pequenas,
+ * com as regiões paralelas internas desativadas) ou fora de qualquer
+ * região paralela (instâncias grandes, com o time inteiro).
+ * @return true em caso de sucesso.
+ */
+static bool solve_batch_job(const batch_job_t* job, const options_t* opts) {
+    read_store_t store;
+    if (!read_loader_load(job->path, &store, NULL)) return false;
+
+    const char* name = strrchr(job->path, '/');
+    name = (name != NULL && opts->output_dir != NULL) ? name + 1 : job->path;
+    size_t size = (opts->output_dir ? strlen(opts->output_dir) + 1 : 0) + strlen(name) + 5;
+    char* output_path = malloc(size);
+    if (opts->output_dir != NULL) {
+        snprintf(output_path, size, "%s/%s.out", opts->output_dir, name);
+    } else {
+        snprintf(output_path, size, "%s.out", name);
+    }
 
-        strings[idx_to_replace] = merged;
+    int n = store.count;
+    char** strings = malloc((n + 1) * sizeof(char*));
+    int* lens = malloc((n + 1) * sizeof(int));
+    for (int i = 0; i < n; ++i) {
+        strings[i] = read_store_get(&store, i);
+        lens[i] = store.len[i];
+    }
+
+    solver_options_t solver = opts->solver;
+    if (solver.packed && !all_acgt(strings, lens, n)) solver.packed = false;
 
-        size_t elems = (size_t)(*count - idx_to_remove - 1);
-        if (elems > 0) {
-            char **tmp = malloc(elems * sizeof(char *));
+    int string_count = n;
+    if (opts->filter && n > 0) {
+        string_count = read_filter_apply(strings, lens, n, true, NULL);
+    }
 
-            // --- BLOCO PARALELO 2 ---
-            t_start = omp_get_wtime();
+    char* result;
+    if (n == 0) {
+        result = strdup("");
+    } else if (solver.engine == ENGINE_UF) {
+        result = shortest_superstring_uf(strings, lens, string_count, &solver);
+    } else if (solver.engine == ENGINE_COMPONENTS) {
+        result = shortest_superstring_components(strings, lens, string_count, &solver);
+    } else {
+        result = shortest_superstring(strings, lens, &string_count, &solver, NULL);
+    }
 
-            #pragma omp parallel for schedule(static)
-            for (size_t t = 0; t < elems; ++t) {
-                tmp[t] = strings[idx_to_remove + 1 + t];
-            }
+    bool ok = false;
+    FILE* out = result != NULL ? fopen(output_path, "w") : NULL;
+    if (result == NULL) {
+        fprintf(stderr, "%s: instância grande demais\n", job->path);
+    } else if (out == NULL) {
+        perror(output_path);
+    } else {
+        ok = fprintf(out, "%s\n", result) >= 0;
+        ok = (fclose(out) == 0) && ok;
+    }
 
-            #pragma omp parallel for schedule(static)
-            for (size_t t = 0; t < elems; ++t) {
-                strings[idx_to_remove + t] = tmp[t];
-            }
+    free(result);
+    free(output_path);
+    free(strings);
+    free(lens);
+    read_store_free(&store);
+    return ok;
+}
 
-            t_end = omp_get_wtime();
-            parallel_time_total += (t_end - t_start);
-            // --- FIM BLOCO PARALELO 2 ---
+/**
+ * @brief Modo lote: resolve todas as instâncias num único processo. As
+ * grandes vêm primeiro, uma de cada vez, cada uma com o time inteiro; as
+ * pequenas são distribuídas dinamicamente, uma por thread, com as regiões
+ * paralelas internas reduzidas a uma thread. O OpenMP reaproveita as
+ * mesmas threads em todas as regiões, então não há criação de processo
+ * nem de time por instância.
+ * @return O número de instâncias que falharam, ou -1 se a lista não pôde
+ * ser lida.
+ */
+static int run_batch(options_t* opts) {
+    batch_job_t* jobs;
+    int bad;
+    int num_jobs = collect_batch_jobs(opts->batch, &jobs, &bad);
+    if (num_jobs < 0) return -1;
+
+    opts->solver.quiet = true;
+    omp_set_max_active_levels(1);
+    double t_start = omp_get_wtime();
+
+    int num_large = 0;
+    while (num_large < num_jobs && jobs[num_large].size >= BATCH_LARGE_BYTES) num_large++;
+
+    // Entradas da lista que não existem ou não podem ser lidas contam como falhas
+    int failures = bad;
+    for (int k = 0; k < num_large; ++k) {
+        if (!solve_batch_job(&jobs[k], opts)) failures++;
+    }
 
-            free(tmp);
-        }        
-        (*count)--;
+    #pragma omp parallel for schedule(dynamic, 1) reduction(+:failures)
+    for (int k = num_large; k < num_jobs; ++k) {
+        if (!solve_batch_job(&jobs[k], opts)) failures++;
     }
 
-    fprintf(stderr, "Tempo total das regiões paralelas: %.6f segundos\n", parallel_time_total);
-    return strdup(strings[0]);
+    fprintf(stderr, "Lote: %d instâncias (%d grandes, %d falhas) em %.6f segundos\n",
+            num_jobs + bad, num_large, failures, omp_get_wtime() - t_start);
+
+    for (int k = 0; k < num_jobs; ++k) free(jobs[k].path);
+    free(jobs);
+    return failures;
 }
 
-int main() {
+/**
+ * @brief Mostra as opções aceitas.
+ */
+void print_usage(const char* program) {
+    fprintf(stderr,
+            "Uso: %s [opções] [entrada]\n"
+            "  entrada                   arquivo com contagem + leituras, FASTA ou FASTQ\n"
+            "                            (padrão: entrada padrão)\n"
+            "  --engine=loop|uf|components\n"
+            "                            laço original, union-find ou laço por componente do grafo\n"
+            "  --overlap=simd|ac|batch   kernel de sobreposição\n"
+            "  --packed                  leituras com 2 bits por base\n"
+            "  --tile=B                  blocos B×B na varredura de pares (padrão: pela L2)\n"
+            "  --min-overlap=K           sobreposições menores que K contam como zero (engines uf e components)\n"
+            "  --seeds                   só verifica pares com semente comum de K bases (uf e components)\n"
+            "  --filter                  remove leituras repetidas ou contidas em outra\n"
+            "  --endcaps                 contigs só com as janelas das pontas (exige --filter)\n"
+            "  --top-k=K                 guarda só os K melhores candidatos por leitura (engine uf)\n"
+            "  --memory=MB               limita a fase de fusão a MB MiB, escolhendo K (engine uf)\n"
+            "  --exact                   superstring ótima (até %d leituras não contidas)\n"
+            "  --trace=PREFIXO           grava PREFIXO.json e PREFIXO.trace.json com tempos por fase\n"
+            "  --checkpoint=ARQUIVO      grava o estado periodicamente em ARQUIVO (engine loop)\n"
+            "  --checkpoint-every=S      segundos entre pontos de controle (padrão: 300)\n"
+            "  --resume                  retoma a partir do ponto de controle\n"
+            "  --batch=LISTA|DIR         resolve cada arquivo da lista (um por linha) ou do diretório\n"
+            "  --output-dir=DIR          saídas do modo lote em DIR/<nome>.out (padrão: <entrada>.out)\n",
+            program, EXACT_MAX_READS);
+}
+
+/**
+ * @brief Lê as opções de linha de comando.
+ * * @param argc Número de argumentos.
+ * @param argv Os argumentos.
+ * @param opts Estrutura preenchida com as opções.
+ * @param input_path Arquivo de entrada (NULL = entrada padrão).
+ * @return true se todas as opções foram reconhecidas.
+ */
+bool parse_options(int argc, char** argv, options_t* opts, const char** input_path) {
+    *input_path = NULL;
+    solver_options_init(&opts->solver);
+    opts->exact = false;
+    opts->filter = false;
+    opts->trace = NULL;
+    opts->resume = false;
+    opts->batch = NULL;
+    opts->output_dir = NULL;
+
+    for (int a = 1; a < argc; ++a) {
+        if (strcmp(argv[a], "--engine=loop") == 0) {
+            opts->solver.engine = ENGINE_LOOP;
+        } else if (strcmp(argv[a], "--engine=uf") == 0) {
+            opts->solver.engine = ENGINE_UF;
+        } else if (strcmp(argv[a], "--engine=components") == 0) {
+            opts->solver.engine = ENGINE_COMPONENTS;
+        } else if (strcmp(argv[a], "--overlap=simd") == 0) {
+            opts->solver.overlap = OVERLAP_SIMD;
+        } else if (strcmp(argv[a], "--overlap=ac") == 0) {
+            opts->solver.overlap = OVERLAP_AC;
+        } else if (strcmp(argv[a], "--overlap=batch") == 0) {
+            opts->solver.overlap = OVERLAP_BATCH;
+        } else if (strcmp(argv[a], "--packed") == 0) {
+            opts->solver.packed = true;
+        } else if (strncmp(argv[a], "--tile=", 7) == 0 && atoi(argv[a] + 7) > 0) {
+            opts->solver.tile = atoi(argv[a] + 7);
+        } else if (strncmp(argv[a], "--min-overlap=", 14) == 0 && atoi(argv[a] + 14) > 0) {
+            opts->solver.min_overlap = atoi(argv[a] + 14);
+        } else if (strcmp(argv[a], "--seeds") == 0) {
+            opts->solver.seeds = true;
+        } else if (strcmp(argv[a], "--filter") == 0) {
+            opts->filter = true;
+        } else if (strcmp(argv[a], "--endcaps") == 0) {
+            opts->solver.endcaps = true;
+        } else if (strncmp(argv[a], "--top-k=", 8) == 0 && atoi(argv[a] + 8) > 0) {
+            opts->solver.top_k = atoi(argv[a] + 8);
+        } else if (strncmp(argv[a], "--memory=", 9) == 0 && atof(argv[a] + 9) > 0) {
+            opts->solver.memory_budget = (size_t)(atof(argv[a] + 9) * 1024 * 1024);
+        } else if (strcmp(argv[a], "--exact") == 0) {
+            opts->exact = true;
+        } else if (strncmp(argv[a], "--trace=", 8) == 0 && argv[a][8] != '\0') {
+            opts->trace = argv[a] + 8;
+        } else if (strncmp(argv[a], "--checkpoint=", 13) == 0 && argv[a][13] != '\0') {
+            opts->solver.checkpoint = argv[a] + 13;
+        } else if (strncmp(argv[a], "--checkpoint-every=", 19) == 0 && atof(argv[a] + 19) >= 0) {
+            opts->solver.checkpoint_every = atof(argv[a] + 19);
+        } else if (strcmp(argv[a], "--resume") == 0) {
+            opts->resume = true;
+        } else if (strncmp(argv[a], "--batch=", 8) == 0 && argv[a][8] != '\0') {
+            opts->batch = argv[a] + 8;
+        } else if (strncmp(argv[a], "--output-dir=", 13) == 0 && argv[a][13] != '\0') {
+            opts->output_dir = argv[a] + 13;
+        } else if (argv[a][0] != '-' && *input_path == NULL) {
+            *input_path = argv[a];
+        } else {
+            fprintf(stderr, "Opção desconhecida: %s\n", argv[a]);
+            print_usage(argv[0]);
+            return false;
+        }
+    }
+    const char* error = solver_options_check(&opts->solver, opts->filter, opts->exact);
+    if (error != NULL) {
+        fprintf(stderr, "%s\n", error);
+        return false;
+    }
+    if (opts->resume && opts->solver.checkpoint == NULL) {
+        fprintf(stderr, "--resume exige --checkpoint=ARQUIVO\n");
+        return false;
+    }
+    if (opts->batch != NULL && (*input_path != NULL || opts->exact || opts->solver.checkpoint || opts->trace)) {
+        fprintf(stderr, "--batch não combina com entrada, --exact, --checkpoint ou --trace\n");
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
     int n;
+    options_t opts;
+    const char* input_path;
 
     //omp_set_num_threads(NUM_THREADS);
 
-    if (scanf("%d", &n) != 1 || n < 0) {
-        fprintf(stderr, "Entrada inválida para o número de strings.\n");
+#ifdef USE_MPI
+    // Só o processo 0 imprime; as coletivas ficam fora das regiões paralelas
+    // ou dentro de um 'single', então MPI_THREAD_SERIALIZED basta
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+#endif
+
+    if (!parse_options(argc, argv, &opts, &input_path)) {
+#ifdef USE_MPI
+        MPI_Finalize();
+#endif
+        return 1;
+    }
+
+    if (opts.batch != NULL) {
+        int failures = -1;
+        if (mpi_size > 1) {
+            if (mpi_rank == 0) fprintf(stderr, "--batch roda num único processo\n");
+        } else {
+            failures = run_batch(&opts);
+        }
+#ifdef USE_MPI
+        MPI_Finalize();
+#endif
+        return failures == 0 ? 0 : 1;
+    }
+
+    // As tarefas de cada componente rodam num processo só
+    if (opts.solver.engine == ENGINE_COMPONENTS && mpi_size > 1) {
+        if (mpi_rank == 0) fprintf(stderr, "--engine=components roda num único processo\n");
+#ifdef USE_MPI
+        MPI_Finalize();
+#endif
+        return 1;
+    }
+
+    // O armazém top-k é consultado pela fase de fusão, num processo só
+    if ((opts.solver.top_k > 0 || opts.solver.memory_budget > 0) && mpi_size > 1) {
+        if (mpi_rank == 0) fprintf(stderr, "--top-k e --memory rodam num único processo\n");
+#ifdef USE_MPI
+        MPI_Finalize();
+#endif
+        return 1;
+    }
+
+    // Só o processo 0 mede: ele faz a leitura e a fase de fusão
+    if (mpi_rank == 0 && opts.trace != NULL) {
+        trace_open(opts.trace);
+    }
+
+    // Todas as leituras ficam numa única arena contígua
+    read_store_t store;
+    n = -1;
+    TRACE_BEGIN(PHASE_PARSE);
+    if (mpi_rank == 0 && read_loader_load(input_path, &store, NULL)) {
+        n = store.count;
+    }
+    TRACE_END(PHASE_PARSE);
+
+#ifdef USE_MPI
+    MPI_Bcast(&n, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    if (n >= 0) {
+        if (mpi_rank != 0) read_store_init(&store, n);
+        broadcast_store(&store, n);
+    }
+#endif
+    if (n < 0) {
+#ifdef USE_MPI
+        MPI_Finalize();
+#endif
         return 1;
     }
-    
-    // Aloca um array de ponteiros para as strings
+
+    if (n == 0) {
+        if (mpi_rank == 0) printf("\n");
+        read_store_free(&store);
+#ifdef USE_MPI
+        MPI_Finalize();
+#endif
+        return 0;
+    }
+
+    // Visões das leituras: ponteiros para a arena e comprimentos em cache
     char** strings = (char**)malloc(n * sizeof(char*));
-    if (strings == NULL && n > 0) {
+    int* lens = (int*)malloc(n * sizeof(int));
+    if (strings == NULL || lens == NULL) {
         perror("Falha ao alocar memória para o array de strings");
         return 1;
     }
-
-    // Buffer temporário para ler cada string
-    char buffer[1024]; 
     for (int i = 0; i < n; ++i) {
-        if (scanf("%1023s", buffer) != 1) {
-            fprintf(stderr, "Erro ao ler a string %d.\n", i + 1);
-            // Libera memória já alocada antes de sair
-            for (int j = 0; j < i; ++j) {
-                free(strings[j]);
-            }
+        strings[i] = read_store_get(&store, i);
+        lens[i] = store.len[i];
+    }
+
+    // O modo compactado só vale para entradas puramente ACGT
+    if (opts.solver.packed && !all_acgt(strings, lens, n)) {
+        if (mpi_rank == 0) fprintf(stderr, "Modo compactado desativado: a entrada contém caracteres fora de ACGT.\n");
+        opts.solver.packed = false;
+    }
+
+    // Leituras repetidas ou contidas em outra não mudam a superstring
+    int string_count = n;
+    if (opts.filter) {
+        read_filter_stats_t stats;
+        string_count = read_filter_apply(strings, lens, n, true, &stats);
+        if (mpi_rank == 0) {
+            fprintf(stderr, "Pré-filtro: %d repetidas e %d contidas removidas (%d -> %d leituras)\n",
+                    stats.duplicates, stats.contained, n, string_count);
+        }
+    }
+
+    // O histórico identifica as leituras de partida; ao retomar, os contigs
+    // do ponto de controle tomam o lugar das leituras
+    merge_history_t history;
+    merge_history_init(&history, strings, lens, string_count);
+    read_store_t contigs;
+    if (opts.resume) {
+        int live = -1;
+        if (mpi_rank == 0) live = resume_from_checkpoint(opts.solver.checkpoint, &history, &contigs);
+#ifdef USE_MPI
+        MPI_Bcast(&live, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        if (live > 0) {
+            if (mpi_rank != 0) read_store_init(&contigs, live);
+            broadcast_store(&contigs, live);
+        }
+#endif
+        if (live < 0) {
+            merge_history_free(&history);
             free(strings);
+            free(lens);
+            read_store_free(&store);
+#ifdef USE_MPI
+            MPI_Finalize();
+#endif
             return 1;
         }
-        strings[i] = strdup(buffer);
+        for (int i = 0; i < live; ++i) {
+            strings[i] = read_store_get(&contigs, i);
+            lens[i] = contigs.len[i];
+        }
+        string_count = live;
     }
-    
-    if (n == 0) {
-        printf("\n");
-        free(strings);
-        return 0;
+
+    char* result;
+    if (opts.exact) {
+        result = shortest_superstring_exact(strings, lens, string_count, &opts.solver);
+    } else if (opts.solver.engine == ENGINE_UF) {
+        result = shortest_superstring_uf(strings, lens, string_count, &opts.solver);
+    } else if (opts.solver.engine == ENGINE_COMPONENTS) {
+        result = shortest_superstring_components(strings, lens, string_count, &opts.solver);
+    } else {
+        result = shortest_superstring(strings, lens, &string_count, &opts.solver, &history);
+    }
+
+    // NULL no processo 0 é uma instância grande demais para o modo pedido;
+    // nos demais processos a engine UF sempre devolve NULL
+    bool failed = (mpi_rank == 0 && result == NULL);
+    if (mpi_rank == 0 && !failed) {
+        printf("%s\n", result);
     }
 
-    int string_count = n;
-    char* result = shortest_superstring(strings, &string_count);
-    
-    printf("%s\n", result);
-    
     // Libera toda a memória alocada
     free(result);
-    for (int i = 0; i < string_count; ++i) {
-        free(strings[i]);
-    }
     free(strings);
+    free(lens);
+    read_store_free(&store);
+    if (opts.resume) {
+        read_store_free(&contigs);
+    }
+    merge_history_free(&history);
+    trace_close();
 
-    return 0;
-}
\ No newline at end of file
+#ifdef USE_MPI
+    MPI_Finalize();
+#endif
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,124 @@
+#include "shsup.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+#include "read_filter.h"
+#include "superstring.h"
+
+void shsup_options_init(shsup_options* opts) {
+    opts->engine = SHSUP_ENGINE_LOOP;
+    opts->overlap = SHSUP_OVERLAP_SIMD;
+    opts->packed = 0;
+    opts->tile = 0;
+    opts->min_overlap = 1;
+    opts->seeds = 0;
+    opts->filter = 0;
+    opts->endcaps = 0;
+    opts->exact = 0;
+    opts->top_k = 0;
+    opts->memory_budget = 0;
+    opts->num_threads = 0;
+}
+
+int shsup_solve(const char* const* reads, const size_t* lens, size_t n, const shsup_options* opts,
+                shsup_result* result) {
+    shsup_options defaults;
+    if (opts == NULL) {
+        shsup_options_init(&defaults);
+        opts = &defaults;
+    }
+    // O resultado fica vazio em qualquer falha, inclusive nas verificações abaixo
+    if (result != NULL) {
+        result->superstring = NULL;
+        result->length = 0;
+    }
+    if (result == NULL || (n > 0 && (reads == NULL || lens == NULL)) || n > INT_MAX) return SHSUP_EINVAL;
+    if (opts->num_threads < 0) return SHSUP_EINVAL;
+    for (size_t i = 0; i < n; ++i) {
+        if (lens[i] > INT_MAX) return SHSUP_EINVAL;
+    }
+
+    // As combinações aceitas são as mesmas do executável
+    solver_options_t solver;
+    solver_options_init(&solver);
+    solver.engine = opts->engine == SHSUP_ENGINE_UF ? ENGINE_UF
+                  : opts->engine == SHSUP_ENGINE_COMPONENTS ? ENGINE_COMPONENTS : ENGINE_LOOP;
+    solver.overlap = opts->overlap == SHSUP_OVERLAP_AC ? OVERLAP_AC
+                   : opts->overlap == SHSUP_OVERLAP_BATCH ? OVERLAP_BATCH : OVERLAP_SIMD;
+    solver.packed = opts->packed;
+    solver.tile = opts->tile;
+    solver.min_overlap = opts->min_overlap;
+    solver.seeds = opts->seeds;
+    solver.endcaps = opts->endcaps;
+    solver.top_k = opts->top_k;
+    solver.memory_budget = opts->memory_budget;
+    solver.quiet = true;
+    if (solver_options_check(&solver, opts->filter, opts->exact) != NULL) return SHSUP_EINVAL;
+
+    if (n == 0) {
+        result->superstring = strdup("");
+        return SHSUP_OK;
+    }
+
+    // Só os vetores de ponteiros e de comprimentos são criados: as engines
+    // rearranjam esses vetores, mas nunca escrevem nas leituras
+    int count = (int)n;
+    char** strings = malloc(n * sizeof(char*));
+    int* int_lens = malloc(n * sizeof(int));
+    for (int i = 0; i < count; ++i) {
+        strings[i] = (char*)reads[i];
+        int_lens[i] = (int)lens[i];
+    }
+
+    // O modo compactado só vale para entradas puramente ACGT
+    solver.packed = solver.packed && all_acgt(strings, int_lens, count);
+
+    int saved_threads = omp_get_max_threads();
+    if (opts->num_threads > 0) omp_set_num_threads(opts->num_threads);
+
+    if (opts->filter) {
+        count = read_filter_apply(strings, int_lens, count, true, NULL);
+    }
+
+    char* superstring;
+    if (opts->exact) {
+        superstring = shortest_superstring_exact(strings, int_lens, count, &solver);
+    } else if (solver.engine == ENGINE_UF) {
+        superstring = shortest_superstring_uf(strings, int_lens, count, &solver);
+    } else if (solver.engine == ENGINE_COMPONENTS) {
+        superstring = shortest_superstring_components(strings, int_lens, count, &solver);
+    } else {
+        superstring = shortest_superstring(strings, int_lens, &count, &solver, NULL);
+    }
+
+    omp_set_num_threads(saved_threads);
+    free(strings);
+    free(int_lens);
+
+    if (superstring == NULL) return SHSUP_ETOOLARGE;
+    result->superstring = superstring;
+    result->length = strlen(superstring);
+    return SHSUP_OK;
+}
+
+void shsup_result_free(shsup_result* result) {
+    free(result->superstring);
+    result->superstring = NULL;
+    result->length = 0;
+}
+
+const char* shsup_strerror(int status) {
+    switch (status) {
+    case SHSUP_OK:
+        return "sucesso";
+    case SHSUP_EINVAL:
+        return "argumento inválido";
+    case SHSUP_ETOOLARGE:
+        return "instância grande demais para o modo pedido";
+    default:
+        return "código desconhecido";
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef SHSUP_H
+#define SHSUP_H
+
+/*
+ * libshsup: API C da superstring gulosa, para ser usada sem passar pelo
+ * executável. Ligar com -lshsup -fopenmp (ou libshsup.a).
+ *
+ *     shsup_options opts;
+ *     shsup_options_init(&opts);
+ *     opts.engine = SHSUP_ENGINE_UF;
+ *     shsup_result result;
+ *     if (shsup_solve(reads, lens, n, &opts, &result) == SHSUP_OK) {
+ *         ... result.superstring, result.length ...
+ *         shsup_result_free(&result);
+ *     }
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    SHSUP_ENGINE_LOOP,      // laço guloso original
+    SHSUP_ENGINE_UF,        // sobreposições calculadas uma vez + union-find
+    SHSUP_ENGINE_COMPONENTS // laço original em cada componente do grafo de sobreposição
+} shsup_engine;
+
+typedef enum {
+    SHSUP_OVERLAP_SIMD,     // um par por vez
+    SHSUP_OVERLAP_AC,       // matriz por Aho-Corasick
+    SHSUP_OVERLAP_BATCH     // blocos de leituras transpostas
+} shsup_overlap;
+
+typedef enum {
+    SHSUP_OK = 0,
+    SHSUP_EINVAL,           // argumento inválido
+    SHSUP_ETOOLARGE         // instância grande demais para o modo pedido
+} shsup_status;
+
+/**
+ * @brief Opções de shsup_solve(). Use shsup_options_init() antes de mudar
+ * os campos, para que novos campos recebam o valor padrão.
+ */
+typedef struct shsup_options {
+    shsup_engine engine;
+    shsup_overlap overlap;
+    int packed;             // leituras com 2 bits por base (só SHSUP_OVERLAP_SIMD e entradas ACGT)
+    int tile;               // lado dos blocos da varredura de pares (0 = automático)
+    int min_overlap;        // sobreposições menores contam como zero (engines UF e de componentes)
+    int seeds;              // candidatos por sementes de min_overlap bases (engines UF e de componentes)
+    int filter;             // remove leituras repetidas e contidas antes
+    int endcaps;            // contigs só com as janelas das pontas (exige filter; engines loop e de componentes)
+    int exact;              // superstring ótima (poucas leituras)
+    int top_k;              // engine UF: guarda só os k melhores candidatos por leitura (0 = todos)
+    size_t memory_budget;   // engine UF: bytes para a fase de fusão; limita k (0 = sem limite)
+    int num_threads;        // threads do OpenMP (0 = o padrão do OpenMP)
+} shsup_options;
+
+/**
+ * @brief Resultado de shsup_solve(); liberar com shsup_result_free().
+ */
+typedef struct shsup_result {
+    char* superstring;      // termina em '\0'
+    size_t length;
+} shsup_result;
+
+/**
+ * @brief Preenche as opções padrão (engine loop, kernel SIMD, sem filtro).
+ */
+void shsup_options_init(shsup_options* opts);
+
+/**
+ * @brief Calcula a superstring gulosa das leituras. As leituras não são
+ * copiadas nem modificadas e não precisam terminar em '\0'; o resultado é
+ * o mesmo do executável shortest_superstring_parallel com as mesmas opções.
+ * * @param reads Ponteiro para o início de cada leitura.
+ * @param lens O comprimento de cada leitura.
+ * @param n O número de leituras.
+ * @param opts As opções, ou NULL para as padrão.
+ * @param result Recebe a superstring.
+ * @return SHSUP_OK, ou o motivo da falha (result fica vazio).
+ */
+int shsup_solve(const char* const* reads, const size_t* lens, size_t n, const shsup_options* opts,
+                shsup_result* result);
+
+/**
+ * @brief Libera a superstring de um resultado.
+ */
+void shsup_result_free(shsup_result* result);
+
+/**
+ * @brief Descrição de um código de retorno de shsup_solve().
+ */
+const char* shsup_strerror(int status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1643 @@
+#include "superstring.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include <limits.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "components.h"
+#include "contig_rope.h"
+#include "exact_superstring.h"
+#include "overlap_ac.h"
+#include "overlap_batch.h"
+#include "overlap_fixed.h"
+#include "overlap_store.h"
+#include "packed_dna.h"
+#include "read_filter.h"
+#include "seed_index.h"
+#include "trace.h"
+
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+
+/*
+ * Modo distribuído (compilado com -DUSE_MPI): todos os processos têm uma
+ * cópia das leituras e cada um calcula as sobreposições de um bloco
+ * contíguo de linhas; os resultados são combinados com coletivas MPI.
+ */
+static int mpi_rank = 0;
+static int mpi_size = 1;
+
+/**
+ * @brief Lê o processo e o número de processos de MPI_COMM_WORLD (no
+ * modo sem MPI, ficam 0 e 1).
+ */
+static void query_mpi(void) {
+#ifdef USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+#endif
+}
+
+void solver_options_init(solver_options_t* opts) {
+    opts->engine = ENGINE_LOOP;
+    opts->overlap = OVERLAP_SIMD;
+    opts->packed = false;
+    opts->tile = 0;
+    opts->min_overlap = 1;
+    opts->seeds = false;
+    opts->checkpoint = NULL;
+    opts->checkpoint_every = 300.0;
+    opts->quiet = false;
+    opts->untraced = false;
+    opts->contigs = false;
+    opts->endcaps = false;
+    opts->top_k = 0;
+    opts->memory_budget = 0;
+}
+
+const char* solver_options_check(const solver_options_t* opts, bool filter, bool exact) {
+    if (opts->min_overlap < 1 || opts->tile < 0 || opts->top_k < 0) {
+        return "--min-overlap, --tile e --top-k precisam ser positivos";
+    }
+    if (opts->engine == ENGINE_LOOP && (opts->seeds || opts->min_overlap > 1)) {
+        return "--min-overlap e --seeds exigem --engine=uf ou --engine=components";
+    }
+    if (opts->checkpoint != NULL && (opts->engine != ENGINE_LOOP || exact)) {
+        return "--checkpoint exige --engine=loop";
+    }
+    if (opts->endcaps && (!filter || opts->engine == ENGINE_UF || opts->checkpoint != NULL)) {
+        return "--endcaps exige --filter e --engine=loop ou components, sem --checkpoint";
+    }
+    if ((opts->top_k > 0 || opts->memory_budget > 0) &&
+        (opts->engine != ENGINE_UF || opts->overlap != OVERLAP_SIMD || exact)) {
+        return "--top-k e --memory exigem --engine=uf e --overlap=simd";
+    }
+    return NULL;
+}
+
+/**
+ * @brief Intervalo de linhas [begin, end) de um conjunto com 'count'
+ * linhas que cabe ao processo 'rank'.
+ */
+static void rows_of_rank(int count, int rank, int* begin, int* end) {
+    *begin = (int)((long long)count * rank / mpi_size);
+    *end = (int)((long long)count * (rank + 1) / mpi_size);
+}
+
+/**
+ * @brief Calcula o comprimento do maior sufixo de 'a' que é também um prefixo de 'b'.
+ * * @param a A primeira string.
+ * @param len_a O comprimento de 'a'.
+ * @param b A segunda string.
+ * @param len_b O comprimento de 'b'.
+ * @return O comprimento da sobreposição.
+ */
+int calculate_overlap_simd(const char* a, int len_a, const char* b, int len_b) {
+    int max_overlap = 0;
+    int min_length = (len_a < len_b) ? len_a : len_b;
+
+    // Itera do maior overlap possível para o menor
+    for (int i = min_length; i > 0; --i) {
+        const char* suffix_a = a + len_a - i;
+        const char* prefix_b = b;
+
+        bool is_match = true;
+
+        // Pedimos ao compilador para vetorizar este loop de comparação.
+        // A cláusula `reduction` garante que a variável `is_match`
+        // seja tratada corretamente pelas threads SIMD.
+        #pragma omp simd reduction(&:is_match)
+        for (int k = 0; k < i; ++k) {
+            is_match = is_match && (suffix_a[k] == prefix_b[k]);
+        }
+        
+        // Se encontramos uma correspondência, este é o maior overlap possível.
+        // Podemos parar e retornar o valor imediatamente.
+        if (is_match) {
+            max_overlap = i;
+            break; // Otimização: sair cedo, já que encontramos o maior.
+        }
+    }
+    return max_overlap;
+}
+
+/**
+ * @brief Mescla duas strings com base em sua sobreposição.
+ * * @param a A primeira string.
+ * @param len_a O comprimento de 'a'.
+ * @param b A segunda string.
+ * @param len_b O comprimento de 'b'.
+ * @param overlap_len O comprimento da sobreposição (sufixo de 'a' e prefixo de 'b').
+ * @param pool Pool de onde a nova string é alocada; ela vive até o pool ser liberado.
+ * @return A fusão, com comprimento len_a + len_b - overlap_len.
+ */
+char* merge_strings(const char* a, int len_a, const char* b, int len_b, int overlap_len, string_pool_t* pool) {
+    int new_len = len_a + len_b - overlap_len;
+
+    char* result = string_pool_alloc(pool, new_len + 1);
+
+    // Copia string a para result
+    memcpy(result, a, len_a);
+    memcpy(result + len_a, b + overlap_len, len_b - overlap_len);
+    result[new_len] = '\0';
+
+    return result;
+}
+
+/**
+ * @brief Escolhe o lado B dos blocos B×B da varredura de pares de modo que
+ * as 2·B strings de um bloco (e seus ponteiros e comprimentos) ocupem no
+ * máximo metade da cache L2.
+ * * @param lens O comprimento de cada string.
+ * @param count O número de strings.
+ * @return O lado do bloco, entre 16 e 1024.
+ */
+static int choose_tile_size(const int* lens, int count) {
+    long l2 = -1;
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+    if (l2 <= 0) l2 = 256 * 1024;
+
+    size_t total = 0;
+    for (int k = 0; k < count; ++k) total += lens[k];
+    size_t per_string = (count > 0 ? total / count : 1) + 1 + sizeof(char*) + sizeof(int);
+
+    size_t tile = (size_t)l2 / 2 / (2 * per_string);
+    if (tile < 16) tile = 16;
+    if (tile > 1024) tile = 1024;
+    return (int)tile;
+}
+
+/**
+ * @brief Compara duas strings como strcmp, mas pelos comprimentos: as
+ * leituras recebidas não precisam terminar em '\0'.
+ */
+static int compare_reads(const char* a, int len_a, const char* b, int len_b) {
+    int cmp = memcmp(a, b, len_a < len_b ? len_a : len_b);
+    if (cmp != 0) return cmp;
+    return (len_a > len_b) - (len_a < len_b);
+}
+
+/**
+ * @brief Compara os contigs das posições 'x' e 'y': pelas strings ou, com
+ * janelas nas pontas, pelos nós da árvore de fusões ('rope' != NULL).
+ */
+static int compare_slots(char** strings, const int* lens, const contig_rope_t* rope, const int* nodes,
+                         int x, int y) {
+    if (rope != NULL) return contig_rope_compare(rope, nodes[x], nodes[y]);
+    return compare_reads(strings[x], lens[x], strings[y], lens[y]);
+}
+
+// Uma cópia por thread: o modo lote resolve várias instâncias ao mesmo tempo
+static const char** rank_sort_strings;
+static const int* rank_sort_lens;
+static const contig_rope_t* rank_sort_rope;
+static const int* rank_sort_nodes;
+#pragma omp threadprivate(rank_sort_strings, rank_sort_lens, rank_sort_rope, rank_sort_nodes)
+
+static int compare_by_string(const void* x, const void* y) {
+    int i = *(const int*)x;
+    int j = *(const int*)y;
+    int cmp = compare_slots((char**)rank_sort_strings, rank_sort_lens, rank_sort_rope, rank_sort_nodes, i, j);
+    if (cmp != 0) return cmp;
+    return (i > j) - (i < j);
+}
+
+/**
+ * @brief Calcula a ordem lexicográfica das strings (empates pela posição).
+ * * @param strings As strings.
+ * @param lens O comprimento de cada string.
+ * @param rope Árvore de fusões dos contigs (NULL = comparar as strings).
+ * @param nodes O nó de cada posição em 'rope'.
+ * @param count O número de strings.
+ * @param order Recebe as posições em ordem lexicográfica.
+ * @param rank Recebe, para cada posição, o seu lugar em 'order'.
+ */
+static void rank_init(char** strings, const int* lens, const contig_rope_t* rope, const int* nodes,
+                      int count, int* order, int* rank) {
+    for (int k = 0; k < count; ++k) order[k] = k;
+    rank_sort_strings = (const char**)strings;
+    rank_sort_lens = lens;
+    rank_sort_rope = rope;
+    rank_sort_nodes = nodes;
+    qsort(order, count, sizeof(int), compare_by_string);
+    for (int r = 0; r < count; ++r) rank[order[r]] = r;
+}
+
+/**
+ * @brief Atualiza a ordem lexicográfica depois de uma fusão: as posições
+ * 'best_i' e 'best_j' saem, as posições depois de 'removed' descem uma casa
+ * e a string fundida (na posição 'replaced') entra por busca binária.
+ * * @param strings As strings já atualizadas (count - 1 strings vivas).
+ * @param lens Os comprimentos, também já atualizados.
+ * @param rope Árvore de fusões (NULL = comparar as strings).
+ * @param nodes Os nós de cada posição, também já atualizados.
+ * @param count O número de strings antes da fusão.
+ */
+static void rank_after_merge(char** strings, const int* lens, const contig_rope_t* rope, const int* nodes,
+                             int count, int* order, int* rank, int best_i, int best_j, int replaced, int removed) {
+    int m = 0;
+    for (int r = 0; r < count; ++r) {
+        int slot = order[r];
+        if (slot == best_i || slot == best_j) continue;
+        order[m++] = (slot > removed) ? slot - 1 : slot;
+    }
+
+    int lo = 0, hi = m;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        int cmp = compare_slots(strings, lens, rope, nodes, order[mid], replaced);
+        if (cmp < 0 || (cmp == 0 && order[mid] < replaced)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    memmove(order + lo + 1, order + lo, (m - lo) * sizeof(int));
+    order[lo] = replaced;
+
+    for (int r = 0; r <= m; ++r) rank[order[r]] = r;
+}
+
+/**
+ * @brief Codifica um par candidato numa chave de 64 bits cujo máximo é o
+ * par escolhido pelo laço original: sobreposição nos bits altos e, abaixo
+ * dela, os ranks de i e de j invertidos (rank menor = chave maior).
+ */
+static inline uint64_t pair_key(int overlap, int rank_i, int rank_j, int rank_bits) {
+    uint64_t rank_max = ((uint64_t)1 << rank_bits) - 1;
+    return ((uint64_t)overlap << (2 * rank_bits))
+         | ((rank_max - rank_i) << rank_bits)
+         | (rank_max - rank_j);
+}
+
+/**
+ * @brief Encontra a superstring mais curta com o laço guloso original.
+ *
+ * Um único time de threads vive durante toda a resolução: a cada iteração
+ * as threads dividem dinamicamente os blocos B×B do espaço de pares (as
+ * 2·B strings de um bloco ficam na L1/L2 enquanto ele é varrido), e a fusão
+ * e a remoção (um memmove sequencial) são feitas por uma só thread, sem
+ * abrir novas regiões paralelas. As threads ficam presas aos núcleos
+ * (proc_bind) e as leituras são copiadas por elas mesmas no início, para
+ * que as páginas sejam distribuídas entre os nós NUMA (first touch).
+ *
+ * O desempate lexicográfico usa o rank de cada string, mantido a cada
+ * fusão; cada candidato vira uma chave de 64 bits (pair_key) e o melhor par
+ * é uma redução max, sem seção crítica nem strcmp na varredura. O
+ * resultado é o mesmo para qualquer número de threads.
+ *
+ * Com MPI cada processo varre só o seu bloco de linhas; as chaves locais
+ * são combinadas com MPI_Allreduce(MPI_MAX) e todos os processos aplicam a
+ * mesma fusão às suas cópias.
+ *
+ * Com --checkpoint, o processo 0 grava os contigs vivos e o histórico de
+ * fusões a cada 'checkpoint_every' segundos; retomar desses contigs
+ * reproduz exatamente o restante da execução.
+ *
+ * Com 'endcaps', cada contig é só a árvore das suas fusões e as janelas das
+ * pontas (contig_rope.h): as sobreposições comparam a janela de trás de i
+ * com a da frente de j, uma fusão copia no máximo duas janelas em vez dos
+ * dois contigs, e o texto completo só é escrito no fim. O resultado é o
+ * mesmo, desde que nenhuma leitura seja substring de outra.
+ *
+ * * @param strings Um array de strings (os ponteiros são rearranjados; ao
+ * final apontam para os contigs, em ordem lexicográfica, dentro do
+ * resultado, sem '\0' entre eles).
+ * @param lens O comprimento de cada string (rearranjado junto com 'strings').
+ * @param count O número de strings; ao final, o número de contigs (1 fora do
+ * modo de contigs).
+ * @param opts Opções; definem como as sobreposições são calculadas e se
+ * há pontos de controle.
+ * @param history Histórico das fusões, continuado a cada fusão e gravado
+ * nos pontos de controle (pode ser NULL se não houver pontos de controle).
+ * @return A superstring mais curta, ou NULL se a entrada for grande demais
+ * para a chave de 64 bits. O chamador deve liberar a memória.
+ */
+char* shortest_superstring(char** strings, int* lens, int* count, const solver_options_t* opts,
+                           merge_history_t* history) {
+    double parallel_time_total = 0.0;  // acumulador do tempo paralelo
+    query_mpi();
+
+    // Bits para os ranks; o que sobra da chave guarda a sobreposição
+    int rank_bits = 1;
+    while (((int64_t)1 << rank_bits) < *count) rank_bits++;
+    size_t total_len = 0;
+    for (int k = 0; k < *count; ++k) total_len += lens[k];
+    if (2 * rank_bits >= 64 || (total_len >> (64 - 2 * rank_bits)) != 0) {
+        fprintf(stderr, "Entrada grande demais para a chave de 64 bits.\n");
+        return NULL;
+    }
+
+    // Contigs gerados pelas fusões; 'live_bytes' é o tamanho somado das strings vivas
+    string_pool_t pool;
+    string_pool_init(&pool);
+    size_t live_bytes = 0;
+    int max_len = 0;
+    for (int k = 0; k < *count; ++k) {
+        live_bytes += lens[k] + 1;
+        if (lens[k] > max_len) max_len = lens[k];
+    }
+
+    // Os sufixos vêm de 'tails' e os prefixos de 'strings'. Com janelas nas
+    // pontas (contig_rope.h), 'strings'/'lens' passam a ser as janelas da
+    // frente, 'tails'/'tail_lens' as de trás e 'nodes' o contig de cada
+    // posição na árvore de fusões; sem elas, são os mesmos vetores
+    bool endcaps = opts->endcaps;
+    contig_rope_t rope;
+    char** tails = strings;
+    int* tail_lens = lens;
+    int* nodes = NULL;
+    if (endcaps) {
+        contig_rope_init(&rope, 2 * *count, max_len, &pool);
+        tails = malloc((*count + 1) * sizeof(char*));
+        tail_lens = malloc((*count + 1) * sizeof(int));
+        nodes = malloc((*count + 1) * sizeof(int));
+    }
+
+    // Cópia compactada de cada string, mantida em paralelo ao array 'strings'
+    // (e de cada janela de trás, em 'packed_tails')
+    packed_read_t* packed = NULL;
+    packed_read_t* packed_tails = NULL;
+    if (opts->packed && opts->overlap == OVERLAP_SIMD) {
+        packed = malloc(*count * sizeof(packed_read_t));
+        for (int k = 0; k < *count; ++k) {
+            pack_read(strings[k], lens[k], &packed[k]);
+        }
+        packed_tails = packed;
+        if (endcaps) {
+            packed_tails = malloc(*count * sizeof(packed_read_t));
+            for (int k = 0; k < *count; ++k) {
+                pack_read(strings[k], lens[k], &packed_tails[k]);
+            }
+        }
+    }
+
+    // Ordem lexicográfica das strings vivas, usada nos desempates
+    int* order = malloc((*count + 1) * sizeof(int));
+    int* rank = malloc((*count + 1) * sizeof(int));
+    rank_init(strings, lens, NULL, NULL, *count, order, rank);
+
+    // Leituras de um só comprimento L usam o kernel especializado nos pares
+    // em que os dois lados ainda têm L bases (com janelas, todos os pares)
+    int fixed_len;
+    overlap_kernel_t fixed_kernel = overlap_fixed_select(lens, *count, &fixed_len);
+
+    uint64_t best_key = 0;
+    bool stop = false;
+    bool compact = false;
+    int tile_size = opts->tile > 0 ? opts->tile : choose_tile_size(lens, *count);
+
+    // Cópia das leituras no pool, escrita em paralelo logo abaixo
+    char* first_touch = string_pool_alloc(&pool, live_bytes);
+    size_t* first_touch_offset = malloc((*count + 1) * sizeof(size_t));
+    first_touch_offset[0] = 0;
+    for (int k = 0; k < *count; ++k) first_touch_offset[k + 1] = first_touch_offset[k] + lens[k] + 1;
+
+    // O engine de componentes chama este laço de dentro de tarefas
+    bool traced = !opts->untraced;
+
+    double t_start = omp_get_wtime();
+    double last_checkpoint = t_start;
+
+    #pragma omp parallel proc_bind(spread)
+    {
+        #pragma omp for schedule(static)
+        for (int k = 0; k < *count; ++k) {
+            memcpy(first_touch + first_touch_offset[k], strings[k], lens[k]);
+            first_touch[first_touch_offset[k] + lens[k]] = '\0';
+            strings[k] = first_touch + first_touch_offset[k];
+        }
+
+        // As leituras copiadas são as folhas; como a janela é a maior
+        // leitura, as duas janelas de cada folha são a leitura inteira
+        if (endcaps) {
+            #pragma omp single
+            for (int k = 0; k < *count; ++k) {
+                nodes[k] = contig_rope_leaf(&rope, strings[k], lens[k]);
+                tails[k] = strings[k];
+                tail_lens[k] = lens[k];
+            }
+        }
+
+        while (*count > 1) {
+            int n = *count;
+            int row_begin, row_end;
+            rows_of_rank(n, mpi_rank, &row_begin, &row_end);
+
+            #pragma omp single
+            {
+                best_key = 0;
+                TRACE_BEGIN_IF(traced, PHASE_OVERLAP);
+            }
+
+            int* overlaps = NULL;
+            if (opts->overlap == OVERLAP_AC) {
+                overlaps = overlap_matrix_ac_team(tails, tail_lens, strings, lens, n, row_begin, row_end);
+            } else if (opts->overlap == OVERLAP_BATCH) {
+                overlaps = overlap_matrix_batch_team(tails, tail_lens, strings, lens, n, row_begin, row_end);
+            }
+
+            // Com a matriz pronta, o resto da varredura é só seleção. Sem
+            // matriz, as sobreposições são calculadas na própria varredura,
+            // que conta como sobreposição; a seleção começa depois da redução
+            if (opts->overlap != OVERLAP_SIMD) {
+                #pragma omp master
+                {
+                    TRACE_END_IF(traced, PHASE_OVERLAP);
+                    TRACE_BEGIN_IF(traced, PHASE_SELECTION);
+                }
+            }
+
+            // --- encontrar melhor par: blocos B×B distribuídos dinamicamente ---
+            int tile_rows = (row_end - row_begin + tile_size - 1) / tile_size;
+            int tile_cols = (n + tile_size - 1) / tile_size;
+
+            #pragma omp for schedule(dynamic, 1) reduction(max:best_key)
+            for (int tile = 0; tile < tile_rows * tile_cols; ++tile) {
+                int i_begin = row_begin + (tile / tile_cols) * tile_size;
+                int j_begin = (tile % tile_cols) * tile_size;
+                int i_end = (i_begin + tile_size < row_end) ? i_begin + tile_size : row_end;
+                int j_end = (j_begin + tile_size < n) ? j_begin + tile_size : n;
+
+                for (int i = i_begin; i < i_end; ++i) {
+                    for (int j = j_begin; j < j_end; ++j) {
+                        if (i == j) continue;
+
+                        int current_overlap;
+                        if (overlaps) {
+                            current_overlap = overlaps[(size_t)(i - row_begin) * n + j];
+                        } else if (packed) {
+                            current_overlap = calculate_overlap_packed(&packed_tails[i], &packed[j]);
+                        } else if (fixed_kernel && tail_lens[i] == fixed_len && lens[j] == fixed_len) {
+                            current_overlap = fixed_kernel(tails[i], fixed_len, strings[j], fixed_len);
+                        } else {
+                            current_overlap = calculate_overlap_simd(tails[i], tail_lens[i], strings[j], lens[j]);
+                        }
+
+                        uint64_t key = pair_key(current_overlap, rank[i], rank[j], rank_bits);
+                        if (key > best_key) best_key = key;
+                    }
+                }
+            }
+
+            #pragma omp single
+            {
+                free(overlaps);
+                if (opts->overlap == OVERLAP_SIMD) {
+                    TRACE_END_IF(traced, PHASE_OVERLAP);
+                    TRACE_BEGIN_IF(traced, PHASE_SELECTION);
+                }
+
+#ifdef USE_MPI
+                MPI_Allreduce(MPI_IN_PLACE, &best_key, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD);
+#endif
+
+                // Modo de contigs: sem sobreposição >= min_overlap, as fusões param
+                stop = opts->contigs && (int)(best_key >> (2 * rank_bits)) < opts->min_overlap;
+                if (stop) TRACE_END_IF(traced, PHASE_SELECTION);
+            }
+            if (stop) break;
+
+            // --- fusão e remoção, feitas por uma única thread ---
+            #pragma omp single
+            {
+                uint64_t rank_max = ((uint64_t)1 << rank_bits) - 1;
+                int max_overlap = (int)(best_key >> (2 * rank_bits));
+                int best_i = order[rank_max - ((best_key >> rank_bits) & rank_max)];
+                int best_j = order[rank_max - (best_key & rank_max)];
+
+                TRACE_END_IF(traced, PHASE_SELECTION);
+                TRACE_ITERATION_IF(traced, (long long)(row_end - row_begin) * (n - 1), max_overlap, n);
+                TRACE_BEGIN_IF(traced, PHASE_MERGE);
+                if (history != NULL) merge_history_push(history, best_i, best_j, max_overlap);
+
+                int idx_to_replace = (best_i < best_j) ? best_i : best_j;
+                int idx_to_remove = (best_i > best_j) ? best_i : best_j;
+
+                // Com janelas, só as janelas da fusão são escritas; o texto
+                // completo fica na árvore até o fim
+                int merged_len;
+                char* merged;
+                if (endcaps) {
+                    int node = contig_rope_merge(&rope, nodes[best_i], nodes[best_j], max_overlap);
+                    merged_len = contig_rope_window_len(&rope, node);
+                    merged = (char*)rope.nodes[node].head;
+                    nodes[idx_to_replace] = node;
+                    tails[idx_to_replace] = (char*)rope.nodes[node].tail;
+                    tail_lens[idx_to_replace] = merged_len;
+                } else {
+                    merged_len = lens[best_i] + lens[best_j] - max_overlap;
+                    merged = merge_strings(strings[best_i], lens[best_i], strings[best_j], lens[best_j],
+                                           max_overlap, &pool);
+                }
+
+                strings[idx_to_replace] = merged;
+                lens[idx_to_replace] = merged_len;
+                live_bytes -= max_overlap + 1;
+
+                size_t elems = (size_t)(n - idx_to_remove - 1);
+                if (packed) {
+                    packed_read_free(&packed[best_i]);
+                    packed_read_free(&packed[best_j]);
+                    pack_read(merged, merged_len, &packed[idx_to_replace]);
+                    memmove(packed + idx_to_remove, packed + idx_to_remove + 1, elems * sizeof(packed_read_t));
+                }
+                if (packed_tails != packed) {
+                    packed_read_free(&packed_tails[best_i]);
+                    packed_read_free(&packed_tails[best_j]);
+                    pack_read(tails[idx_to_replace], tail_lens[idx_to_replace], &packed_tails[idx_to_replace]);
+                    memmove(packed_tails + idx_to_remove, packed_tails + idx_to_remove + 1,
+                            elems * sizeof(packed_read_t));
+                }
+                memmove(strings + idx_to_remove, strings + idx_to_remove + 1, elems * sizeof(char*));
+                memmove(lens + idx_to_remove, lens + idx_to_remove + 1, elems * sizeof(int));
+                if (endcaps) {
+                    memmove(tails + idx_to_remove, tails + idx_to_remove + 1, elems * sizeof(char*));
+                    memmove(tail_lens + idx_to_remove, tail_lens + idx_to_remove + 1, elems * sizeof(int));
+                    memmove(nodes + idx_to_remove, nodes + idx_to_remove + 1, elems * sizeof(int));
+                }
+                rank_after_merge(strings, lens, endcaps ? &rope : NULL, nodes, n, order, rank,
+                                 best_i, best_j, idx_to_replace, idx_to_remove);
+                (*count)--;
+                TRACE_END_IF(traced, PHASE_MERGE);
+
+                // O pool só cresce; quando passa do dobro do que está vivo, é
+                // compactado logo abaixo, pelo time. As janelas não são: cada
+                // fusão gasta no máximo 2·window bytes e a árvore aponta para elas
+                compact = !endcaps && pool.bytes > 2 * live_bytes + (1 << 20);
+                if (compact) TRACE_BEGIN_IF(traced, PHASE_COMPACTION);
+
+                // Os ranks não são salvos: rank_init() sobre os contigs
+                // vivos reconstrói exatamente a mesma ordem
+                if (opts->checkpoint != NULL && mpi_rank == 0 && *count > 1 &&
+                    omp_get_wtime() - last_checkpoint >= opts->checkpoint_every) {
+                    checkpoint_save(opts->checkpoint, history, strings, lens, *count);
+                    last_checkpoint = omp_get_wtime();
+                }
+            }
+
+            // Todas as threads copiam, na mesma divisão da cópia inicial
+            if (compact) {
+                string_pool_compact(&pool, strings, lens, *count);
+                #pragma omp single
+                TRACE_END_IF(traced, PHASE_COMPACTION);
+            }
+        }
+    }
+
+    parallel_time_total += omp_get_wtime() - t_start;
+
+    free(rank);
+    free(first_touch_offset);
+
+    if (packed) {
+        for (int k = 0; k < *count; ++k) packed_read_free(&packed[k]);
+        free(packed);
+    }
+    if (packed_tails != packed) {
+        for (int k = 0; k < *count; ++k) packed_read_free(&packed_tails[k]);
+        free(packed_tails);
+    }
+
+    if (mpi_rank == 0 && !opts->quiet) {
+        fprintf(stderr, "Tempo total das regiões paralelas: %.6f segundos\n", parallel_time_total);
+    }
+
+    // Os contigs restantes (um só, fora do modo de contigs) são concatenados
+    // em ordem lexicográfica, e 'strings' passa a apontar para cada um deles
+    // dentro do resultado. Com janelas, este é o único momento em que o
+    // texto completo é escrito, direto da árvore para o resultado
+    if (endcaps) {
+        for (int k = 0; k < *count; ++k) lens[k] = rope.nodes[nodes[k]].len;
+    }
+    size_t result_len = 0;
+    for (int k = 0; k < *count; ++k) result_len += lens[k];
+    char* result = malloc(result_len + 1);
+    int* contig_lens = malloc((*count + 1) * sizeof(int));
+    if (result == NULL || contig_lens == NULL) {
+        perror("Falha ao alocar memória em shortest_superstring");
+        exit(EXIT_FAILURE);
+    }
+    size_t pos = 0;
+    for (int r = 0; r < *count; ++r) {
+        if (endcaps) {
+            contig_rope_write(&rope, nodes[order[r]], result + pos);
+        } else {
+            memcpy(result + pos, strings[order[r]], lens[order[r]]);
+        }
+        contig_lens[r] = lens[order[r]];
+        pos += lens[order[r]];
+    }
+    result[pos] = '\0';
+    pos = 0;
+    for (int r = 0; r < *count; ++r) {
+        strings[r] = result + pos;
+        lens[r] = contig_lens[r];
+        pos += contig_lens[r];
+    }
+    free(contig_lens);
+    free(order);
+    if (endcaps) {
+        contig_rope_free(&rope);
+        free(tails);
+        free(tail_lens);
+        free(nodes);
+    }
+    string_pool_release(&pool);
+    return result;
+}
+
+/**
+ * @brief Aresta candidata (a -> b) do grafo de sobreposições.
+ * A sobreposição fica implícita no balde em que a aresta está guardada.
+ */
+typedef struct {
+    int a;
+    int b;
+} edge_t;
+
+/**
+ * @brief Grupo de arestas de um balde que compartilham a mesma origem.
+ * As arestas do grupo estão em ordem lexicográfica do destino; 'pos'
+ * aponta para o primeiro destino ainda não descartado.
+ */
+typedef struct {
+    int a;
+    int pos;
+    int end;
+} edge_group_t;
+
+/**
+ * @brief Entrada do heap de grupos, ordenada por (rank da cabeça do
+ * contig que termina em 'a', rank do destino).
+ */
+typedef struct {
+    int key_head;
+    int key_b;
+    int group;
+} heap_entry_t;
+
+static bool heap_less(const heap_entry_t* x, const heap_entry_t* y) {
+    if (x->key_head != y->key_head) return x->key_head < y->key_head;
+    return x->key_b < y->key_b;
+}
+
+static void heap_push(heap_entry_t* heap, int* size, heap_entry_t e) {
+    int k = (*size)++;
+    while (k > 0) {
+        int parent = (k - 1) / 2;
+        if (!heap_less(&e, &heap[parent])) break;
+        heap[k] = heap[parent];
+        k = parent;
+    }
+    heap[k] = e;
+}
+
+static heap_entry_t heap_pop(heap_entry_t* heap, int* size) {
+    heap_entry_t top = heap[0];
+    heap_entry_t last = heap[--(*size)];
+    int k = 0;
+    for (;;) {
+        int child = 2 * k + 1;
+        if (child >= *size) break;
+        if (child + 1 < *size && heap_less(&heap[child + 1], &heap[child])) child++;
+        if (!heap_less(&heap[child], &last)) break;
+        heap[k] = heap[child];
+        k = child;
+    }
+    if (*size > 0) heap[k] = last;
+    return top;
+}
+
+static int uf_find(int* parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+#ifdef USE_MPI
+/**
+ * @brief Reúne no processo 0 as arestas calculadas por todos os processos.
+ * * @param row_edges Arestas de cada linha; no processo 0 passa a conter todas.
+ * @param row_size Número de arestas de cada linha.
+ * @param count O número de linhas.
+ * @return true no processo 0; nos demais as linhas locais são liberadas.
+ */
+static bool gather_rows_at_root(int** row_edges, int* row_size, int count) {
+    int row_begin, row_end;
+    rows_of_rank(count, mpi_rank, &row_begin, &row_end);
+    int local_rows = row_end - row_begin;
+
+    int local_ints = 0;
+    for (int a = row_begin; a < row_end; ++a) local_ints += 2 * row_size[a];
+    int* local_data = malloc((local_ints + 1) * sizeof(int));
+    int pos = 0;
+    for (int a = row_begin; a < row_end; ++a) {
+        memcpy(local_data + pos, row_edges[a], 2 * row_size[a] * sizeof(int));
+        pos += 2 * row_size[a];
+        free(row_edges[a]);
+    }
+
+    int* rows_per_rank = NULL;
+    int* row_displs = NULL;
+    int* ints_per_rank = NULL;
+    int* int_displs = NULL;
+    int* all_data = NULL;
+    if (mpi_rank == 0) {
+        rows_per_rank = malloc(mpi_size * sizeof(int));
+        row_displs = malloc(mpi_size * sizeof(int));
+        ints_per_rank = malloc(mpi_size * sizeof(int));
+        int_displs = malloc(mpi_size * sizeof(int));
+        for (int p = 0; p < mpi_size; ++p) {
+            int b, e;
+            rows_of_rank(count, p, &b, &e);
+            rows_per_rank[p] = e - b;
+            row_displs[p] = b;
+        }
+    }
+
+    MPI_Gatherv(row_size + row_begin, local_rows, MPI_INT,
+                row_size, rows_per_rank, row_displs, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Gather(&local_ints, 1, MPI_INT, ints_per_rank, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+    if (mpi_rank == 0) {
+        long long total = 0;
+        for (int p = 0; p < mpi_size; ++p) {
+            int_displs[p] = (int)total;
+            total += ints_per_rank[p];
+        }
+        all_data = malloc((total + 1) * sizeof(int));
+    }
+    MPI_Gatherv(local_data, local_ints, MPI_INT,
+                all_data, ints_per_rank, int_displs, MPI_INT, 0, MPI_COMM_WORLD);
+    free(local_data);
+
+    if (mpi_rank != 0) return false;
+
+    long long offset = 0;
+    for (int a = 0; a < count; ++a) {
+        row_edges[a] = malloc((2 * row_size[a] + 1) * sizeof(int));
+        memcpy(row_edges[a], all_data + offset, 2 * row_size[a] * sizeof(int));
+        offset += 2 * row_size[a];
+    }
+    free(all_data);
+    free(rows_per_rank);
+    free(row_displs);
+    free(ints_per_rank);
+    free(int_displs);
+    return true;
+}
+#endif
+
+// Threadprivate: cada thread que chama qsort() atribui a sua cópia
+static const int* edge_sort_rank;
+#pragma omp threadprivate(edge_sort_rank)
+
+/**
+ * @brief Ordena pares (destino, sobreposição) pelo rank do destino.
+ */
+static int compare_edge_by_rank(const void* x, const void* y) {
+    int rx = edge_sort_rank[*(const int*)x];
+    int ry = edge_sort_rank[*(const int*)y];
+    return (rx > ry) - (rx < ry);
+}
+
+/**
+ * @brief Monta a superstring a partir das fusões aceitas: cada contig é a
+ * cadeia que começa numa leitura sem antecessor, e os contigs (que não se
+ * sobrepõem) são concatenados em ordem lexicográfica, como o laço original
+ * faz com sobreposição zero.
+ * * @param next O sucessor de cada leitura (-1 = nenhum).
+ * @param next_overlap A sobreposição com o sucessor.
+ * @param has_in Se a leitura tem antecessor.
+ * @return A superstring; o chamador deve liberar a memória.
+ */
+static char* assemble_chains(char** strings, const int* lens, int count, const int* by_rank,
+                             const int* next, const int* next_overlap, const bool* has_in) {
+    size_t total_len = 0;
+    for (int i = 0; i < count; ++i) total_len += lens[i] - next_overlap[i];
+
+    char* result = malloc(total_len + 1);
+    if (result == NULL) {
+        perror("Falha ao alocar memória em shortest_superstring_uf");
+        exit(EXIT_FAILURE);
+    }
+    size_t pos = 0;
+    for (int r = 0; r < count; ++r) {
+        int s = by_rank[r];
+        if (has_in[s]) continue;
+        int skip = 0;
+        for (int x = s; x != -1; x = next[x]) {
+            memcpy(result + pos, strings[x] + skip, lens[x] - skip);
+            pos += lens[x] - skip;
+            skip = next_overlap[x];
+        }
+    }
+    result[pos] = '\0';
+    return result;
+}
+
+/**
+ * @brief Contexto do cálculo das linhas do armazém top-k (overlap_store.h).
+ * Depois da carga inicial 'has_in' e 'parent' passam a apontar para o
+ * estado das fusões, e as recargas já descartam os destinos que nunca mais
+ * poderão ser aceitos.
+ */
+typedef struct {
+    char** strings;
+    const int* lens;
+    int count;
+    int min_overlap;
+    overlap_kernel_t overlap;
+    const packed_read_t* packed;
+    const seed_index_t* seeds;  // NULL = varredura de todos os pares
+    int** seen;                 // rascunho de seed_index_overlaps(), por thread
+    const bool* has_in;         // NULL na carga inicial
+    int* parent;
+} store_rows_t;
+
+static int store_row_candidates(void* ctx, int a, int* out) {
+    store_rows_t* rows = ctx;
+    int m = 0;
+    if (rows->seeds) {
+        // As marcas de 'seen' são desfeitas: a mesma linha pode ser recalculada
+        int* seen = rows->seen[omp_get_thread_num()];
+        m = seed_index_overlaps(rows->seeds, rows->strings, rows->lens, a, out, seen);
+        for (int e = 0; e < m; ++e) seen[out[2 * e]] = -1;
+    } else {
+        for (int b = 0; b < rows->count; ++b) {
+            if (a == b) continue;
+            int ov;
+            if (rows->packed) {
+                ov = calculate_overlap_packed(&rows->packed[a], &rows->packed[b]);
+            } else {
+                ov = rows->overlap(rows->strings[a], rows->lens[a], rows->strings[b], rows->lens[b]);
+            }
+            if (ov >= rows->min_overlap) {
+                out[2 * m] = b;
+                out[2 * m + 1] = ov;
+                m++;
+            }
+        }
+    }
+    if (rows->has_in == NULL) return m;
+
+    int root_a = uf_find(rows->parent, a);
+    int kept = 0;
+    for (int e = 0; e < m; ++e) {
+        int b = out[2 * e];
+        if (rows->has_in[b] || uf_find(rows->parent, b) == root_a) continue;
+        out[2 * kept] = b;
+        out[2 * kept + 1] = out[2 * e + 1];
+        kept++;
+    }
+    return kept;
+}
+
+/**
+ * @brief Memória da fase de fusão fora do armazém: o estado por leitura e
+ * os rascunhos por thread das linhas. As leituras e o índice de sementes
+ * ficam de fora.
+ */
+static size_t store_fixed_bytes(int count, const solver_options_t* opts) {
+    size_t threads = omp_get_max_threads();
+    size_t per_read = 10 * sizeof(int) + sizeof(bool) + 2 * sizeof(heap_entry_t);
+    size_t per_thread = 2 * sizeof(int) + (opts->seeds ? sizeof(int) : 0);
+    return (size_t)count * (per_read + (threads + 1) * per_thread);
+}
+
+/**
+ * @brief ENGINE_UF com o armazém top-k (opts->top_k ou opts->memory_budget):
+ * em vez de todas as arestas em baldes, cada leitura guarda só os seus k
+ * melhores candidatos de saída, e a linha é recalculada quando eles acabam.
+ * Os baldes passam a conter as origens cujo candidato da frente tem aquela
+ * sobreposição; a ordem de aceitação é a mesma da engine UF, então o
+ * resultado também é.
+ * @return A superstring, ou NULL se o orçamento não comporta nem um
+ * candidato por leitura.
+ */
+static char* shortest_superstring_uf_store(char** strings, const int* lens, int count, const solver_options_t* opts,
+                                           const int* rank, const int* by_rank, int max_len) {
+    int k = opts->top_k > 0 ? opts->top_k : INT_MAX;
+    if (opts->memory_budget > 0) {
+        size_t fixed = store_fixed_bytes(count, opts);
+        int k_budget = opts->memory_budget > fixed
+                     ? overlap_store_k_for_budget(opts->memory_budget - fixed, count, max_len) : 0;
+        if (k_budget == 0) {
+            if (!opts->quiet) {
+                fprintf(stderr, "Orçamento de memória pequeno demais para %d leituras\n", count);
+            }
+            return NULL;
+        }
+        if (k_budget < k) k = k_budget;
+    }
+
+    // --- BLOCO PARALELO: os k melhores candidatos de cada leitura ---
+    double t_start = omp_get_wtime();
+    TRACE_BEGIN(PHASE_OVERLAP);
+
+    seed_index_t seeds;
+    store_rows_t rows = { strings, lens, count, opts->min_overlap, NULL, NULL, NULL, NULL, NULL, NULL };
+    int fixed_len;
+    rows.overlap = overlap_fixed_select(lens, count, &fixed_len);
+    if (rows.overlap == NULL) rows.overlap = calculate_overlap_simd;
+
+    int num_threads = omp_get_max_threads();
+    if (opts->seeds) {
+        seed_index_build(&seeds, strings, lens, count, opts->min_overlap);
+        rows.seeds = &seeds;
+        rows.seen = malloc(num_threads * sizeof(int*));
+        for (int t = 0; t < num_threads; ++t) {
+            rows.seen[t] = malloc(count * sizeof(int));
+            for (int b = 0; b < count; ++b) rows.seen[t][b] = -1;
+        }
+    }
+    packed_read_t* packed = NULL;
+    if (!opts->seeds && opts->packed) {
+        packed = malloc(count * sizeof(packed_read_t));
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < count; ++i) {
+            pack_read(strings[i], lens[i], &packed[i]);
+        }
+        rows.packed = packed;
+    }
+
+    overlap_store_t store;
+    overlap_store_init(&store, count, k, rank, by_rank, store_row_candidates, &rows);
+
+    double parallel_time_total = omp_get_wtime() - t_start;
+    // --- FIM BLOCO PARALELO ---
+    TRACE_END(PHASE_OVERLAP);
+    TRACE_BEGIN(PHASE_SELECTION);
+
+    int* parent = malloc(count * sizeof(int));
+    int* head = malloc(count * sizeof(int));
+    int* tail = malloc(count * sizeof(int));
+    int* next = malloc(count * sizeof(int));
+    int* next_overlap = calloc(count, sizeof(int));
+    bool* has_in = calloc(count, sizeof(bool));
+    int* group_of = malloc(count * sizeof(int));
+    int* group_a = malloc((count + 1) * sizeof(int));
+    int* bucket_head = malloc((max_len + 1) * sizeof(int));
+    int* bucket_next = malloc(count * sizeof(int));
+    heap_entry_t* heap = malloc((2 * count + 1) * sizeof(heap_entry_t));
+    for (int i = 0; i < count; ++i) {
+        parent[i] = head[i] = tail[i] = i;
+        next[i] = -1;
+        group_of[i] = -1;
+    }
+    for (int ov = 0; ov <= max_len; ++ov) bucket_head[ov] = -1;
+
+    // Cada origem fica no balde da sobreposição do seu candidato da frente
+    for (int a = 0; a < count; ++a) {
+        int b, ov;
+        if (overlap_store_front(&store, a, &b, &ov)) {
+            bucket_next[a] = bucket_head[ov];
+            bucket_head[ov] = a;
+        }
+    }
+    rows.has_in = has_in;
+    rows.parent = parent;
+    int merges = 0;
+
+    for (int ov = max_len; ov > 0; --ov) {
+        if (bucket_head[ov] == -1) continue;
+
+        int num_groups = 0;
+        int heap_size = 0;
+        for (int a = bucket_head[ov]; a != -1; a = bucket_next[a]) {
+            int b, front_ov;
+            overlap_store_front(&store, a, &b, &front_ov);
+            group_a[num_groups] = a;
+            group_of[a] = num_groups;
+            heap_entry_t entry = { rank[head[uf_find(parent, a)]], rank[b], num_groups };
+            heap_push(heap, &heap_size, entry);
+            num_groups++;
+        }
+        bucket_head[ov] = -1;
+        TRACE_ITERATION(num_groups, ov, count - merges);
+
+        while (heap_size > 0) {
+            heap_entry_t top = heap_pop(heap, &heap_size);
+            int a = group_a[top.group];
+            if (next[a] != -1) continue;
+
+            // Descarta destinos que já têm antecessor ou fechariam um ciclo
+            int root_a = uf_find(parent, a);
+            int b, front_ov;
+            bool alive = false;
+            while (overlap_store_front(&store, a, &b, &front_ov) && front_ov == ov) {
+                if (!has_in[b] && uf_find(parent, b) != root_a) {
+                    alive = true;
+                    break;
+                }
+                overlap_store_pop(&store, a);
+            }
+            if (!alive) continue;
+
+            heap_entry_t current = { rank[head[root_a]], rank[b], top.group };
+            if (current.key_head != top.key_head || current.key_b != top.key_b) {
+                heap_push(heap, &heap_size, current);
+                continue;
+            }
+
+            // Aceita a fusão a -> b; 'a' não precisa de mais candidatos
+            int root_b = uf_find(parent, b);
+            int new_head = head[root_a];
+            int new_tail = tail[root_b];
+            next[a] = b;
+            next_overlap[a] = ov;
+            has_in[b] = true;
+            parent[root_b] = root_a;
+            head[root_a] = new_head;
+            tail[root_a] = new_tail;
+            overlap_store_release(&store, a);
+            merges++;
+
+            // A origem que termina o novo contig mudou de cabeça
+            int t = group_of[new_tail];
+            int tail_b, tail_ov;
+            if (t != -1 && next[new_tail] == -1 && overlap_store_front(&store, new_tail, &tail_b, &tail_ov) &&
+                tail_ov == ov) {
+                heap_entry_t entry = { rank[new_head], rank[tail_b], t };
+                heap_push(heap, &heap_size, entry);
+            }
+        }
+
+        // As origens que sobraram seguem para o balde do próximo candidato
+        for (int g = 0; g < num_groups; ++g) {
+            int a = group_a[g];
+            int b, front_ov;
+            group_of[a] = -1;
+            if (next[a] == -1 && overlap_store_front(&store, a, &b, &front_ov)) {
+                bucket_next[a] = bucket_head[front_ov];
+                bucket_head[front_ov] = a;
+            }
+        }
+    }
+
+    TRACE_END(PHASE_SELECTION);
+    TRACE_BEGIN(PHASE_MERGE);
+    char* result = assemble_chains(strings, lens, count, by_rank, next, next_overlap, has_in);
+    TRACE_END(PHASE_MERGE);
+
+    if (!opts->quiet) {
+        fprintf(stderr, "Armazém top-k: %d candidatos por leitura, pico de %.1f MiB, %lld recargas\n",
+                store.k, store.peak_bytes / (1024.0 * 1024.0), store.refills);
+        fprintf(stderr, "Tempo total das regiões paralelas: %.6f segundos\n", parallel_time_total);
+    }
+
+    overlap_store_free(&store);
+    if (opts->seeds) {
+        for (int t = 0; t < num_threads; ++t) free(rows.seen[t]);
+        free(rows.seen);
+        seed_index_free(&seeds);
+    }
+    if (packed) {
+        for (int i = 0; i < count; ++i) packed_read_free(&packed[i]);
+        free(packed);
+    }
+    free(heap);
+    free(bucket_next);
+    free(bucket_head);
+    free(group_a);
+    free(group_of);
+    free(has_in);
+    free(next_overlap);
+    free(next);
+    free(tail);
+    free(head);
+    free(parent);
+    return result;
+}
+
+/**
+ * @brief Engine gulosa com union-find: calcula cada sobreposição uma única
+ * vez, distribui os pares em baldes por comprimento de sobreposição e aceita
+ * as fusões da maior para a menor sobreposição.
+ *
+ * Um par (a, b) é aceito se 'a' ainda não tem sucessor, 'b' ainda não tem
+ * antecessor e ambos estão em contigs diferentes (evita ciclos). Dentro de
+ * um balde os empates seguem o laço original: menor contig de origem (em
+ * ordem lexicográfica da sua primeira leitura) e depois menor destino.
+ * O resultado coincide com o de shortest_superstring() quando nenhuma
+ * leitura é substring de outra.
+ *
+ * Com MPI cada processo calcula as sobreposições de um bloco de linhas;
+ * as arestas são reunidas no processo 0, que faz sozinho a fase de fusão.
+ *
+ * @param strings As leituras de entrada (não são modificadas).
+ * @param lens O comprimento de cada leitura.
+ * @param count O número de leituras.
+ * @param opts Opções; definem como as sobreposições são calculadas.
+ * @return A superstring (NULL nos processos MPI diferentes de 0). O chamador
+ * deve liberar a memória.
+ */
+char* shortest_superstring_uf(char** strings, const int* lens, int count, const solver_options_t* opts) {
+    double parallel_time_total = 0.0;
+    query_mpi();
+
+    int* by_rank = malloc(count * sizeof(int));
+    int* rank = malloc(count * sizeof(int));
+    int max_len = 0;
+    for (int i = 0; i < count; ++i) {
+        if (lens[i] > max_len) max_len = lens[i];
+        by_rank[i] = i;
+    }
+
+    // Ordem lexicográfica das leituras, usada em todos os desempates
+    rank_sort_strings = (const char**)strings;
+    rank_sort_lens = lens;
+    rank_sort_rope = NULL;
+    qsort(by_rank, count, sizeof(int), compare_by_string);
+    for (int r = 0; r < count; ++r) rank[by_rank[r]] = r;
+
+    if (opts->top_k > 0 || opts->memory_budget > 0) {
+        char* result = shortest_superstring_uf_store(strings, lens, count, opts, rank, by_rank, max_len);
+        free(rank);
+        free(by_rank);
+        return result;
+    }
+
+    // --- BLOCO PARALELO: todas as sobreposições, uma única vez ---
+    double t_start = omp_get_wtime();
+    TRACE_BEGIN(PHASE_OVERLAP);
+
+    // Arestas de saída de cada leitura (pares destino, sobreposição), com
+    // destinos em ordem de rank; cada processo calcula o seu bloco de linhas
+    int** row_edges = malloc(count * sizeof(int*));
+    int* row_size = calloc(count, sizeof(int));
+    int row_begin, row_end;
+    rows_of_rank(count, mpi_rank, &row_begin, &row_end);
+
+    // Com sementes, só os pares que compartilham um k-mer são verificados
+    seed_index_t seeds;
+    if (opts->seeds) {
+        seed_index_build(&seeds, strings, lens, count, opts->min_overlap);
+    }
+
+    // Todas as sobreposições são entre leituras: com um só comprimento, o
+    // kernel especializado vale para todos os pares
+    int fixed_len;
+    overlap_kernel_t overlap = overlap_fixed_select(lens, count, &fixed_len);
+    if (overlap == NULL) overlap = calculate_overlap_simd;
+
+    packed_read_t* packed = NULL;
+    if (!opts->seeds && opts->overlap == OVERLAP_SIMD && opts->packed) {
+        packed = malloc(count * sizeof(packed_read_t));
+        #pragma omp parallel for schedule(static)
+        for (int k = 0; k < count; ++k) {
+            pack_read(strings[k], lens[k], &packed[k]);
+        }
+    }
+
+    #pragma omp parallel proc_bind(spread)
+    {
+        int* overlaps = NULL;
+        if (opts->seeds) {
+            // nenhuma matriz densa
+        } else if (opts->overlap == OVERLAP_AC) {
+            overlaps = overlap_matrix_ac_team(strings, lens, strings, lens, count, row_begin, row_end);
+        } else if (opts->overlap == OVERLAP_BATCH) {
+            overlaps = overlap_matrix_batch_team(strings, lens, strings, lens, count, row_begin, row_end);
+        }
+
+        // Cada thread ordena as suas linhas: a cópia threadprivate dela
+        // precisa apontar para os ranks
+        edge_sort_rank = rank;
+
+        int* buffer = malloc(2 * count * sizeof(int));
+        int* seen = NULL;
+        if (opts->seeds) {
+            seen = malloc(count * sizeof(int));
+            for (int b = 0; b < count; ++b) seen[b] = -1;
+        }
+
+        #pragma omp for schedule(dynamic, 16)
+        for (int a = row_begin; a < row_end; ++a) {
+            int m = 0;
+            if (opts->seeds) {
+                m = seed_index_overlaps(&seeds, strings, lens, a, buffer, seen);
+                qsort(buffer, m, 2 * sizeof(int), compare_edge_by_rank);
+            }
+            for (int s = 0; s < count && !opts->seeds; ++s) {
+                int b = by_rank[s];
+                if (a == b) continue;
+                int ov;
+                if (overlaps) {
+                    ov = overlaps[(size_t)(a - row_begin) * count + b];
+                } else if (packed) {
+                    ov = calculate_overlap_packed(&packed[a], &packed[b]);
+                } else {
+                    ov = overlap(strings[a], lens[a], strings[b], lens[b]);
+                }
+                if (ov >= opts->min_overlap) {
+                    buffer[2 * m] = b;
+                    buffer[2 * m + 1] = ov;
+                    m++;
+                }
+            }
+            row_edges[a] = malloc((2 * m + 1) * sizeof(int));
+            memcpy(row_edges[a], buffer, 2 * m * sizeof(int));
+            row_size[a] = m;
+        }
+
+        free(buffer);
+        free(seen);
+
+        #pragma omp single
+        free(overlaps);
+    }
+    if (opts->seeds) {
+        seed_index_free(&seeds);
+    }
+    if (packed) {
+        for (int k = 0; k < count; ++k) packed_read_free(&packed[k]);
+        free(packed);
+    }
+
+    double t_end = omp_get_wtime();
+    parallel_time_total += (t_end - t_start);
+    // --- FIM BLOCO PARALELO ---
+
+#ifdef USE_MPI
+    if (!gather_rows_at_root(row_edges, row_size, count)) {
+        free(row_edges);
+        free(row_size);
+        free(rank);
+        free(by_rank);
+        return NULL;
+    }
+#endif
+    TRACE_END(PHASE_OVERLAP);
+    TRACE_BEGIN(PHASE_SELECTION);
+
+    long long* bucket_size = calloc(max_len + 1, sizeof(long long));
+    for (int a = 0; a < count; ++a) {
+        for (int m = 0; m < row_size[a]; ++m) bucket_size[row_edges[a][2 * m + 1]]++;
+    }
+
+    // Bucket sort estável: dentro de cada balde as arestas ficam agrupadas
+    // por origem (em ordem de rank) e com destinos em ordem de rank.
+    long long* bucket_start = malloc((max_len + 2) * sizeof(long long));
+    bucket_start[0] = 0;
+    for (int k = 0; k <= max_len; ++k) bucket_start[k + 1] = bucket_start[k] + bucket_size[k];
+    long long total_edges = bucket_start[max_len + 1];
+
+    edge_t* edges = malloc((total_edges + 1) * sizeof(edge_t));
+    long long* fill = malloc((max_len + 1) * sizeof(long long));
+    memcpy(fill, bucket_start, (max_len + 1) * sizeof(long long));
+    for (int r = 0; r < count; ++r) {
+        int a = by_rank[r];
+        for (int m = 0; m < row_size[a]; ++m) {
+            int ov = row_edges[a][2 * m + 1];
+            edges[fill[ov]].a = a;
+            edges[fill[ov]].b = row_edges[a][2 * m];
+            fill[ov]++;
+        }
+        free(row_edges[a]);
+    }
+    free(row_edges);
+    free(row_size);
+    free(fill);
+    free(bucket_size);
+
+    int* parent = malloc(count * sizeof(int));
+    int* head = malloc(count * sizeof(int));
+    int* tail = malloc(count * sizeof(int));
+    int* next = malloc(count * sizeof(int));
+    int* next_overlap = calloc(count, sizeof(int));
+    bool* has_in = calloc(count, sizeof(bool));
+    int* group_of = malloc(count * sizeof(int));
+    for (int i = 0; i < count; ++i) {
+        parent[i] = head[i] = tail[i] = i;
+        next[i] = -1;
+        group_of[i] = -1;
+    }
+
+    edge_group_t* groups = malloc((count + 1) * sizeof(edge_group_t));
+    heap_entry_t* heap = malloc((2 * count + 1) * sizeof(heap_entry_t));
+    int merges = 0;
+
+    for (int k = max_len; k > 0; --k) {
+        long long begin = bucket_start[k];
+        long long end = bucket_start[k + 1];
+        if (begin == end) continue;
+        TRACE_ITERATION(end - begin, k, count - merges);
+
+        // Agrupa as arestas do balde por origem ainda sem sucessor
+        int num_groups = 0;
+        int heap_size = 0;
+        for (long long e = begin; e < end;) {
+            int a = edges[e].a;
+            long long g_end = e;
+            while (g_end < end && edges[g_end].a == a) g_end++;
+            if (next[a] == -1) {
+                groups[num_groups].a = a;
+                groups[num_groups].pos = (int)(e - begin);
+                groups[num_groups].end = (int)(g_end - begin);
+                group_of[a] = num_groups;
+                heap_entry_t entry = { rank[head[uf_find(parent, a)]], rank[edges[e].b], num_groups };
+                heap_push(heap, &heap_size, entry);
+                num_groups++;
+            }
+            e = g_end;
+        }
+
+        while (heap_size > 0) {
+            heap_entry_t top = heap_pop(heap, &heap_size);
+            edge_group_t* g = &groups[top.group];
+            int a = g->a;
+            if (next[a] != -1) continue;
+
+            // Descarta destinos que já têm antecessor ou fechariam um ciclo
+            int root_a = uf_find(parent, a);
+            while (g->pos < g->end) {
+                int b = edges[begin + g->pos].b;
+                if (!has_in[b] && uf_find(parent, b) != root_a) break;
+                g->pos++;
+            }
+            if (g->pos == g->end) continue;
+
+            int b = edges[begin + g->pos].b;
+            heap_entry_t current = { rank[head[root_a]], rank[b], top.group };
+            if (current.key_head != top.key_head || current.key_b != top.key_b) {
+                heap_push(heap, &heap_size, current);
+                continue;
+            }
+
+            // Aceita a fusão a -> b
+            int root_b = uf_find(parent, b);
+            int new_head = head[root_a];
+            int new_tail = tail[root_b];
+            next[a] = b;
+            next_overlap[a] = k;
+            has_in[b] = true;
+            parent[root_b] = root_a;
+            head[root_a] = new_head;
+            tail[root_a] = new_tail;
+            merges++;
+
+            // A origem que termina o novo contig mudou de cabeça
+            int t = group_of[new_tail];
+            if (t != -1 && next[new_tail] == -1 && groups[t].pos < groups[t].end) {
+                heap_entry_t entry = { rank[new_head], rank[edges[begin + groups[t].pos].b], t };
+                heap_push(heap, &heap_size, entry);
+            }
+        }
+
+        for (int g = 0; g < num_groups; ++g) group_of[groups[g].a] = -1;
+    }
+
+    TRACE_END(PHASE_SELECTION);
+    TRACE_BEGIN(PHASE_MERGE);
+
+    char* result = assemble_chains(strings, lens, count, by_rank, next, next_overlap, has_in);
+    TRACE_END(PHASE_MERGE);
+
+    free(heap);
+    free(groups);
+    free(group_of);
+    free(has_in);
+    free(next_overlap);
+    free(next);
+    free(tail);
+    free(head);
+    free(parent);
+    free(edges);
+    free(bucket_start);
+    free(rank);
+    free(by_rank);
+
+    if (mpi_rank == 0 && !opts->quiet) {
+        fprintf(stderr, "Tempo total das regiões paralelas: %.6f segundos\n", parallel_time_total);
+    }
+    return result;
+}
+
+/**
+ * @brief Componente do grafo de sobreposição, para ordenar por tamanho.
+ */
+typedef struct {
+    int size;
+    int id;
+} component_size_t;
+
+static int compare_component_size(const void* x, const void* y) {
+    const component_size_t* a = x;
+    const component_size_t* b = y;
+    if (a->size != b->size) return a->size < b->size ? 1 : -1;
+    return (a->id > b->id) - (a->id < b->id);
+}
+
+char* shortest_superstring_components(char** strings, const int* lens, int count, const solver_options_t* opts) {
+    double t_start = omp_get_wtime();
+
+    TRACE_BEGIN(PHASE_OVERLAP);
+    int* component = malloc((count + 1) * sizeof(int));
+    int num_components = overlap_components(strings, lens, count, opts->min_overlap, opts->seeds, component);
+    TRACE_END(PHASE_OVERLAP);
+
+    // Leituras agrupadas por componente, na ordem original dentro de cada uma
+    int* start = calloc(num_components + 2, sizeof(int));
+    for (int i = 0; i < count; ++i) start[component[i] + 1]++;
+    for (int c = 0; c < num_components; ++c) start[c + 1] += start[c];
+    char** members = malloc((count + 1) * sizeof(char*));
+    int* member_lens = malloc((count + 1) * sizeof(int));
+    int* fill = malloc((num_components + 1) * sizeof(int));
+    memcpy(fill, start, num_components * sizeof(int));
+    for (int i = 0; i < count; ++i) {
+        int pos = fill[component[i]]++;
+        members[pos] = strings[i];
+        member_lens[pos] = lens[i];
+    }
+    free(fill);
+    free(component);
+
+    component_size_t* by_size = malloc((num_components + 1) * sizeof(component_size_t));
+    for (int c = 0; c < num_components; ++c) {
+        by_size[c].size = start[c + 1] - start[c];
+        by_size[c].id = c;
+    }
+    qsort(by_size, num_components, sizeof(component_size_t), compare_component_size);
+
+    solver_options_t component_opts = *opts;
+    component_opts.engine = ENGINE_LOOP;
+    component_opts.contigs = true;
+    component_opts.quiet = true;
+    component_opts.untraced = true;
+    component_opts.checkpoint = NULL;
+
+    // Cada componente é resolvida no seu trecho de 'members', que ao final
+    // aponta para os contigs dentro de buffers[c]
+    char** buffers = calloc(num_components + 1, sizeof(char*));
+    int* num_contigs = malloc((num_components + 1) * sizeof(int));
+    for (int c = 0; c < num_components; ++c) num_contigs[c] = start[c + 1] - start[c];
+
+    // O rastreamento não é seguro entre tarefas: as componentes rodam sem
+    // pontos de medição e a fase toda conta como seleção
+    TRACE_BEGIN(PHASE_SELECTION);
+
+    // Componentes maiores que a fatia de uma thread usam o time inteiro, uma
+    // de cada vez; as demais viram tarefas, cada uma resolvida por uma thread
+    int threads = omp_get_max_threads();
+    int num_large = 0;
+    while (num_large < num_components && threads > 1 && by_size[num_large].size > count / threads) num_large++;
+    for (int k = 0; k < num_large; ++k) {
+        int c = by_size[k].id;
+        buffers[c] = shortest_superstring(members + start[c], member_lens + start[c], &num_contigs[c],
+                                          &component_opts, NULL);
+    }
+
+    int saved_levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(1);
+    #pragma omp parallel
+    #pragma omp single
+    for (int k = num_large; k < num_components; ++k) {
+        int c = by_size[k].id;
+        #pragma omp task firstprivate(c)
+        buffers[c] = shortest_superstring(members + start[c], member_lens + start[c], &num_contigs[c],
+                                          &component_opts, NULL);
+    }
+    omp_set_max_active_levels(saved_levels);
+    TRACE_END(PHASE_SELECTION);
+
+    bool failed = false;
+    for (int c = 0; c < num_components; ++c) failed = failed || buffers[c] == NULL;
+
+    // Os contigs de todas as componentes, concatenados em ordem lexicográfica
+    // (empates pela componente)
+    char* result = NULL;
+    int total_contigs = 0;
+    if (!failed) {
+        TRACE_BEGIN(PHASE_MERGE);
+        char** contigs = malloc((count + 1) * sizeof(char*));
+        int* contig_lens = malloc((count + 1) * sizeof(int));
+        size_t total_len = 0;
+        for (int c = 0; c < num_components; ++c) {
+            for (int k = 0; k < num_contigs[c]; ++k) {
+                contigs[total_contigs] = members[start[c] + k];
+                contig_lens[total_contigs] = member_lens[start[c] + k];
+                total_len += contig_lens[total_contigs];
+                total_contigs++;
+            }
+        }
+
+        int* order = malloc((total_contigs + 1) * sizeof(int));
+        int* rank = malloc((total_contigs + 1) * sizeof(int));
+        rank_init(contigs, contig_lens, NULL, NULL, total_contigs, order, rank);
+
+        result = malloc(total_len + 1);
+        if (result == NULL) {
+            perror("Falha ao alocar memória em shortest_superstring_components");
+            exit(EXIT_FAILURE);
+        }
+        size_t pos = 0;
+        for (int r = 0; r < total_contigs; ++r) {
+            memcpy(result + pos, contigs[order[r]], contig_lens[order[r]]);
+            pos += contig_lens[order[r]];
+        }
+        result[pos] = '\0';
+
+        free(order);
+        free(rank);
+        free(contigs);
+        free(contig_lens);
+        TRACE_END(PHASE_MERGE);
+    }
+
+    for (int c = 0; c < num_components; ++c) free(buffers[c]);
+    free(buffers);
+    free(num_contigs);
+    free(by_size);
+    free(members);
+    free(member_lens);
+    free(start);
+
+    if (!opts->quiet) {
+        fprintf(stderr, "Componentes: %d (%d resolvidas com o time inteiro), %d contigs\n",
+                num_components, num_large, total_contigs);
+        fprintf(stderr, "Tempo total das regiões paralelas: %.6f segundos\n", omp_get_wtime() - t_start);
+    }
+    return result;
+}
+
+/**
+ * @brief Modo exato: remove as leituras repetidas e contidas e confere o
+ * tamanho da instância antes de tudo; só então roda a gulosa
+ * (shortest_superstring) sobre uma cópia das leituras restantes e usa o seu
+ * comprimento como limite da poda de exact_superstring(). Os dois
+ * comprimentos vão para stderr, para comparar a gulosa com o ótimo.
+ * @return A superstring ótima, ou NULL se a instância for grande demais.
+ */
+char* shortest_superstring_exact(char** strings, const int* lens, int count, const solver_options_t* opts) {
+    char** kept_strings = malloc((count + 1) * sizeof(char*));
+    int* kept_lens = malloc((count + 1) * sizeof(int));
+    memcpy(kept_strings, strings, count * sizeof(char*));
+    memcpy(kept_lens, lens, count * sizeof(int));
+    int kept = count > 0 ? read_filter_apply(kept_strings, kept_lens, count, true, NULL) : 0;
+
+    // Instâncias grandes demais são recusadas sem pagar a gulosa
+    if (kept > EXACT_MAX_READS) {
+        if (mpi_rank == 0) {
+            fprintf(stderr, "Modo exato: %d leituras restantes (máximo %d).\n", kept, EXACT_MAX_READS);
+        }
+        free(kept_strings);
+        free(kept_lens);
+        return NULL;
+    }
+
+    char** greedy_strings = malloc((kept + 1) * sizeof(char*));
+    int* greedy_lens = malloc((kept + 1) * sizeof(int));
+    memcpy(greedy_strings, kept_strings, kept * sizeof(char*));
+    memcpy(greedy_lens, kept_lens, kept * sizeof(int));
+
+    int greedy_count = kept;
+    char* greedy = shortest_superstring(greedy_strings, greedy_lens, &greedy_count, opts, NULL);
+    free(greedy_strings);
+    free(greedy_lens);
+    if (greedy == NULL) {
+        free(kept_strings);
+        free(kept_lens);
+        return NULL;
+    }
+    int greedy_len = strlen(greedy);
+    free(greedy);
+
+    double t_start = omp_get_wtime();
+    char* result = exact_superstring(kept_strings, kept_lens, kept, greedy_len);
+    if (result != NULL && mpi_rank == 0 && !opts->quiet) {
+        fprintf(stderr, "Tempo do modo exato: %.6f segundos\n", omp_get_wtime() - t_start);
+        fprintf(stderr, "Comprimento guloso: %d, ótimo: %zu\n", greedy_len, strlen(result));
+    }
+    free(kept_strings);
+    free(kept_lens);
+    return result;
+}
+
+/**
+ * @brief Verifica se todas as strings contêm apenas as bases A, C, G e T.
+ * * @param strings As strings.
+ * @param lens O comprimento de cada string.
+ * @param count O número de strings.
+ * @return true se nenhuma string tem outro caractere.
+ */
+bool all_acgt(char** strings, const int* lens, int count) {
+    for (int i = 0; i < count; ++i) {
+        for (int k = 0; k < lens[i]; ++k) {
+            char c = strings[i][k];
+            if (c != 'A' && c != 'C' && c != 'G' && c != 'T') return false;
+        }
+    }
+    return true;
+}
+
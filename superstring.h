@@ -0,0 +1,148 @@
+#ifndef SUPERSTRING_H
+#define SUPERSTRING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "checkpoint.h"
+#include "read_store.h"
+
+/**
+ * @brief Engines disponíveis para a fase gulosa.
+ * ENGINE_LOOP é o laço original (varredura n×n a cada fusão);
+ * ENGINE_UF calcula cada sobreposição uma única vez e aceita as fusões
+ * em ordem decrescente de sobreposição usando union-find;
+ * ENGINE_COMPONENTS separa as componentes do grafo de sobreposição
+ * (components.h) e roda o laço original em cada uma, como uma tarefa.
+ */
+typedef enum {
+    ENGINE_LOOP,
+    ENGINE_UF,
+    ENGINE_COMPONENTS
+} engine_t;
+
+/**
+ * @brief Backends de cálculo de sobreposição.
+ * OVERLAP_SIMD compara cada par com calculate_overlap_simd (ou com o kernel
+ * de overlap_fixed.h, se todas as leituras têm o mesmo comprimento);
+ * OVERLAP_AC calcula a matriz de todos os pares com um autômato de Aho-Corasick;
+ * OVERLAP_BATCH compara cada string com blocos de 16/32/64 strings
+ * transpostas de uma vez (overlap_batch.h), com o ISA escolhido em execução.
+ */
+typedef enum {
+    OVERLAP_SIMD,
+    OVERLAP_AC,
+    OVERLAP_BATCH
+} overlap_backend_t;
+
+/**
+ * @brief Opções das engines.
+ * 'packed' troca o kernel por par pela versão com 2 bits por base
+ * (packed_dna.h); só vale para o backend OVERLAP_SIMD.
+ */
+typedef struct {
+    engine_t engine;
+    overlap_backend_t overlap;
+    bool packed;
+    int tile;                   // lado dos blocos da varredura de pares (0 = automático)
+    int min_overlap;            // sobreposições menores contam como zero (engines UF e de componentes)
+    bool seeds;                 // candidatos pelo índice de sementes (seed_index.h), sem varredura n×n
+    const char* checkpoint;     // arquivo do ponto de controle (checkpoint.h); NULL = desligado
+    double checkpoint_every;    // segundos entre dois pontos de controle
+    bool quiet;                 // sem relatórios de tempo em stderr
+    bool untraced;              // sem pontos de medição do rastreamento (trace.h), mesmo se ligado
+    bool contigs;               // o laço original para quando não há sobreposição >= min_overlap
+    bool endcaps;               // contigs só com as janelas das pontas (contig_rope.h); exige leituras filtradas
+    int top_k;                  // ENGINE_UF com o armazém top-k (overlap_store.h): candidatos por leitura (0 = desligado)
+    size_t memory_budget;       // bytes para a fase de fusão do armazém top-k; limita k (0 = sem limite)
+} solver_options_t;
+
+/*
+ * As leituras são passadas como um vetor de ponteiros e um vetor de
+ * comprimentos; os bytes não precisam terminar em '\0' e nunca são
+ * escritos. Com -DUSE_MPI as engines dividem o trabalho entre os processos
+ * de MPI_COMM_WORLD.
+ */
+
+/**
+ * @brief Preenche as opções padrão: engine loop, kernel SIMD, sem pontos
+ * de controle.
+ */
+void solver_options_init(solver_options_t* opts);
+
+/**
+ * @brief Confere as combinações de opções aceitas pelas engines. É a única
+ * validação: o executável e shsup_solve() chamam esta função.
+ * * @param opts As opções.
+ * @param filter Se as leituras repetidas e contidas são removidas antes.
+ * @param exact Se a superstring ótima foi pedida.
+ * @return NULL se as opções são válidas, ou a descrição do problema (em
+ * termos das opções de linha de comando).
+ */
+const char* solver_options_check(const solver_options_t* opts, bool filter, bool exact);
+
+/**
+ * @brief Calcula o comprimento do maior sufixo de 'a' que é também um prefixo de 'b'.
+ */
+int calculate_overlap_simd(const char* a, int len_a, const char* b, int len_b);
+
+/**
+ * @brief Mescla duas strings com base em sua sobreposição; a fusão é
+ * alocada em 'pool' e termina em '\0'.
+ */
+char* merge_strings(const char* a, int len_a, const char* b, int len_b, int overlap_len, string_pool_t* pool);
+
+/**
+ * @brief Verifica se todas as strings contêm apenas as bases A, C, G e T.
+ */
+bool all_acgt(char** strings, const int* lens, int count);
+
+/**
+ * @brief Superstring gulosa com o laço original (ENGINE_LOOP). Com
+ * 'contigs', as fusões param quando a maior sobreposição fica abaixo de
+ * min_overlap e os contigs restantes são concatenados em ordem
+ * lexicográfica. Com 'endcaps' (leituras sem repetidas nem contidas),
+ * as fusões só escrevem as janelas das pontas e o texto é montado no fim.
+ * * @param strings As leituras (o vetor de ponteiros é rearranjado); ao
+ * final aponta para cada contig, em ordem, dentro do resultado.
+ * @param lens O comprimento de cada leitura (rearranjado junto).
+ * @param count O número de leituras; ao final, o número de contigs.
+ * @param opts As opções.
+ * @param history Histórico das fusões, gravado nos pontos de controle
+ * (pode ser NULL se não houver pontos de controle).
+ * @return A superstring, ou NULL se a entrada for grande demais para a
+ * chave de 64 bits. O chamador deve liberar a memória.
+ */
+char* shortest_superstring(char** strings, int* lens, int* count, const solver_options_t* opts,
+                           merge_history_t* history);
+
+/**
+ * @brief Superstring por componentes (ENGINE_COMPONENTS): cada componente
+ * do grafo com sobreposições >= min_overlap é resolvida pelo laço original
+ * até não restar sobreposição >= min_overlap, e todos os contigs são
+ * concatenados em ordem lexicográfica. Sem leituras repetidas ou contidas
+ * (read_filter.h), o resultado é o mesmo de ENGINE_UF com o mesmo min_overlap.
+ * @return A superstring, ou NULL se uma componente for grande demais para a
+ * chave de 64 bits. O chamador deve liberar a memória.
+ */
+char* shortest_superstring_components(char** strings, const int* lens, int count, const solver_options_t* opts);
+
+/**
+ * @brief Superstring gulosa com union-find (ENGINE_UF); mesmo resultado
+ * de shortest_superstring(). Com 'top_k' ou 'memory_budget', as arestas
+ * ficam no armazém esparso de overlap_store.h (O(n·k) em vez de todas as
+ * sobreposições), num processo só; o resultado não muda.
+ * @return A superstring (NULL nos processos MPI diferentes de 0, ou se o
+ * orçamento de memória não comporta um candidato por leitura). O
+ * chamador deve liberar a memória.
+ */
+char* shortest_superstring_uf(char** strings, const int* lens, int count, const solver_options_t* opts);
+
+/**
+ * @brief Superstring ótima (exact_superstring.h), podada pelo comprimento
+ * da gulosa.
+ * @return A superstring, ou NULL se a instância for grande demais.
+ */
+char* shortest_superstring_exact(char** strings, const int* lens, int count, const solver_options_t* opts);
+
+#endif
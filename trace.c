@@ -0,0 +1,227 @@
+#include "trace.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define NUM_COUNTERS 4
+
+typedef struct {
+    trace_phase_t phase;
+    double start;
+    double end;
+} trace_event_t;
+
+typedef struct {
+    double time;
+    long long pairs;
+    int best_overlap;
+    int live;
+} trace_sample_t;
+
+bool trace_enabled = false;
+
+static const char* phase_names[PHASE_COUNT] = {"parse", "overlap", "selection", "merge", "compaction"};
+static const char* counter_names[NUM_COUNTERS] = {"cycles", "instructions", "cache_misses", "branch_misses"};
+
+static char* trace_prefix;
+static double trace_origin;
+
+static trace_event_t* events;
+static int num_events, events_capacity;
+static trace_sample_t* samples;
+static int num_samples, samples_capacity;
+
+static double phase_start[PHASE_COUNT];
+static double phase_total[PHASE_COUNT];
+static int phase_calls[PHASE_COUNT];
+
+static int counter_fds[NUM_COUNTERS] = {-1, -1, -1, -1};
+static uint64_t counter_start[PHASE_COUNT][NUM_COUNTERS];
+static uint64_t counter_total[PHASE_COUNT][NUM_COUNTERS];
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void* grow(void* buffer, int* capacity, size_t size) {
+    *capacity = *capacity ? 2 * *capacity : 1024;
+    buffer = realloc(buffer, *capacity * size);
+    if (buffer == NULL) {
+        perror("Falha ao alocar memória no rastreamento");
+        exit(EXIT_FAILURE);
+    }
+    return buffer;
+}
+
+static void open_counters(void) {
+#ifdef __linux__
+    static const uint64_t configs[NUM_COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES,
+    };
+    for (int c = 0; c < NUM_COUNTERS; ++c) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[c];
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // Só a thread atual: as threads do OpenMP já existem ou são
+        // criadas depois, e com 'inherit' a contagem das filhas só chega ao
+        // descritor quando elas terminam, o que as do OpenMP não fazem. O
+        // resumo marca os contadores como só da thread mestre
+        counter_fds[c] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (counter_fds[c] >= 0) ioctl(counter_fds[c], PERF_EVENT_IOC_ENABLE, 0);
+    }
+    if (counter_fds[0] < 0) fprintf(stderr, "Aviso: contadores de hardware indisponíveis (perf_event_open)\n");
+#endif
+}
+
+static void read_counters(uint64_t* values) {
+    for (int c = 0; c < NUM_COUNTERS; ++c) {
+        values[c] = 0;
+#ifdef __linux__
+        if (counter_fds[c] >= 0 && read(counter_fds[c], &values[c], sizeof(uint64_t)) != sizeof(uint64_t)) values[c] = 0;
+#endif
+    }
+}
+
+void trace_open(const char* prefix) {
+    trace_prefix = strdup(prefix);
+    trace_origin = now();
+    open_counters();
+    trace_enabled = true;
+}
+
+void trace_phase_begin(trace_phase_t phase) {
+    read_counters(counter_start[phase]);
+    phase_start[phase] = now();
+}
+
+void trace_phase_end(trace_phase_t phase) {
+    double end = now();
+    uint64_t values[NUM_COUNTERS];
+    read_counters(values);
+    for (int c = 0; c < NUM_COUNTERS; ++c) counter_total[phase][c] += values[c] - counter_start[phase][c];
+
+    phase_total[phase] += end - phase_start[phase];
+    phase_calls[phase]++;
+
+    if (num_events == events_capacity) events = grow(events, &events_capacity, sizeof(trace_event_t));
+    events[num_events].phase = phase;
+    events[num_events].start = phase_start[phase];
+    events[num_events].end = end;
+    num_events++;
+}
+
+void trace_iteration(long long pairs, int best_overlap, int live) {
+    if (num_samples == samples_capacity) samples = grow(samples, &samples_capacity, sizeof(trace_sample_t));
+    samples[num_samples].time = now();
+    samples[num_samples].pairs = pairs;
+    samples[num_samples].best_overlap = best_overlap;
+    samples[num_samples].live = live;
+    num_samples++;
+}
+
+static FILE* open_output(const char* suffix) {
+    size_t size = strlen(trace_prefix) + strlen(suffix) + 1;
+    char* path = malloc(size);
+    snprintf(path, size, "%s%s", trace_prefix, suffix);
+    FILE* file = fopen(path, "w");
+    if (file == NULL) perror(path);
+    free(path);
+    return file;
+}
+
+/**
+ * @brief Resumo: tempo e contadores de hardware por fase (só da thread que
+ * chamou trace_open(), indicado em "counter_scope"), e os contadores de
+ * cada iteração.
+ */
+static void write_summary(void) {
+    FILE* out = open_output(".json");
+    if (out == NULL) return;
+
+    long long total_pairs = 0;
+    for (int s = 0; s < num_samples; ++s) total_pairs += samples[s].pairs;
+
+    fprintf(out, "{\n  \"counter_scope\": \"master thread only\",\n  \"phases\": {\n");
+    for (int p = 0; p < PHASE_COUNT; ++p) {
+        fprintf(out, "    \"%s\": {\"seconds\": %.6f, \"calls\": %d", phase_names[p], phase_total[p], phase_calls[p]);
+        for (int c = 0; c < NUM_COUNTERS; ++c) {
+            if (counter_fds[c] >= 0) fprintf(out, ", \"%s\": %llu", counter_names[c], (unsigned long long)counter_total[p][c]);
+            else fprintf(out, ", \"%s\": null", counter_names[c]);
+        }
+        fprintf(out, "}%s\n", p + 1 < PHASE_COUNT ? "," : "");
+    }
+    fprintf(out, "  },\n  \"iterations\": %d,\n  \"pairs_scanned\": %lld,\n  \"samples\": [", num_samples, total_pairs);
+    for (int s = 0; s < num_samples; ++s) {
+        fprintf(out, "%s\n    {\"t\": %.6f, \"pairs\": %lld, \"best_overlap\": %d, \"live\": %d}", s ? "," : "",
+                samples[s].time - trace_origin, samples[s].pairs, samples[s].best_overlap, samples[s].live);
+    }
+    fprintf(out, "%s]\n}\n", num_samples ? "\n  " : "");
+    fclose(out);
+}
+
+/**
+ * @brief Linha do tempo no formato Chrome trace: um evento completo ("X")
+ * por chamada de fase e séries de contadores ("C") por iteração.
+ */
+static void write_timeline(void) {
+    FILE* out = open_output(".trace.json");
+    if (out == NULL) return;
+
+    fprintf(out, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+    bool first = true;
+    for (int e = 0; e < num_events; ++e) {
+        fprintf(out, "%s\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": %.3f, \"dur\": %.3f}",
+                first ? "" : ",", phase_names[events[e].phase], (events[e].start - trace_origin) * 1e6,
+                (events[e].end - events[e].start) * 1e6);
+        first = false;
+    }
+    for (int s = 0; s < num_samples; ++s) {
+        fprintf(out, "%s\n{\"name\": \"greedy\", \"ph\": \"C\", \"pid\": 1, \"ts\": %.3f, "
+                "\"args\": {\"pairs\": %lld, \"best_overlap\": %d, \"live\": %d}}",
+                first ? "" : ",", (samples[s].time - trace_origin) * 1e6, samples[s].pairs, samples[s].best_overlap,
+                samples[s].live);
+        first = false;
+    }
+    fprintf(out, "\n]}\n");
+    fclose(out);
+}
+
+void trace_close(void) {
+    if (!trace_enabled) return;
+    trace_enabled = false;
+
+    write_summary();
+    write_timeline();
+
+#ifdef __linux__
+    for (int c = 0; c < NUM_COUNTERS; ++c) {
+        if (counter_fds[c] >= 0) close(counter_fds[c]);
+        counter_fds[c] = -1;
+    }
+#endif
+    free(events);
+    free(samples);
+    free(trace_prefix);
+    events = NULL;
+    samples = NULL;
+    trace_prefix = NULL;
+    num_events = events_capacity = 0;
+    num_samples = samples_capacity = 0;
+}
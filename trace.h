@@ -0,0 +1,72 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Fases medidas pelo rastreamento.
+ */
+typedef enum {
+    PHASE_PARSE,        // leitura da entrada
+    PHASE_OVERLAP,      // cálculo das sobreposições (matriz ou arestas)
+    PHASE_SELECTION,    // escolha do par / das arestas a fundir
+    PHASE_MERGE,        // fusão dos contigs
+    PHASE_COMPACTION,   // compactação do pool de strings
+    PHASE_COUNT
+} trace_phase_t;
+
+/**
+ * @brief Verdadeiro só depois de trace_open(). As macros abaixo testam
+ * esta variável antes de qualquer chamada, então com o rastreamento
+ * desligado o custo é um desvio previsível por ponto de medição.
+ */
+extern bool trace_enabled;
+
+#define TRACE_BEGIN(phase) do { if (trace_enabled) trace_phase_begin(phase); } while (0)
+#define TRACE_END(phase) do { if (trace_enabled) trace_phase_end(phase); } while (0)
+#define TRACE_ITERATION(pairs, best_overlap, live) \
+    do { if (trace_enabled) trace_iteration((pairs), (best_overlap), (live)); } while (0)
+
+/**
+ * @brief As mesmas macros com uma condição a mais, para código que também
+ * roda em tarefas concorrentes, onde não pode medir (ex.: o laço guloso
+ * chamado pelo engine de componentes, com solver_options_t.untraced).
+ */
+#define TRACE_BEGIN_IF(on, phase) do { if (trace_enabled && (on)) trace_phase_begin(phase); } while (0)
+#define TRACE_END_IF(on, phase) do { if (trace_enabled && (on)) trace_phase_end(phase); } while (0)
+#define TRACE_ITERATION_IF(on, pairs, best_overlap, live) \
+    do { if (trace_enabled && (on)) trace_iteration((pairs), (best_overlap), (live)); } while (0)
+
+/**
+ * @brief Liga o rastreamento. Ao final, trace_close() grava
+ * '<prefixo>.json' (resumo por fase e contadores por iteração) e
+ * '<prefixo>.trace.json' (linha do tempo no formato Chrome trace, para
+ * chrome://tracing ou Perfetto). Se o kernel permitir, abre também
+ * contadores de hardware com perf_event_open (ciclos, instruções, faltas
+ * de cache e desvios mal previstos) só da thread que chamou trace_open():
+ * as demais threads do time não entram na contagem.
+ * * @param prefix Prefixo dos arquivos de saída.
+ */
+void trace_open(const char* prefix);
+
+/**
+ * @brief Marca o início/fim de uma fase. Devem ser chamadas por uma única
+ * thread por vez (fora das regiões paralelas ou dentro de 'single'/'master').
+ */
+void trace_phase_begin(trace_phase_t phase);
+void trace_phase_end(trace_phase_t phase);
+
+/**
+ * @brief Registra os contadores de uma iteração da fase gulosa.
+ * * @param pairs Pares (ou arestas) examinados na iteração.
+ * @param best_overlap A sobreposição escolhida.
+ * @param live Leituras ou contigs vivos no início da iteração.
+ */
+void trace_iteration(long long pairs, int best_overlap, int live);
+
+/**
+ * @brief Grava os arquivos e libera a memória do rastreamento.
+ */
+void trace_close(void);
+
+#endif
@@ -0,0 +1,149 @@
+/*
+ * Verificador da saída dos resolvedores: confere se todas as leituras de
+ * entrada aparecem na superstring produzida, com uma única passada de um
+ * autômato de Aho-Corasick de todas elas (strings_in_text_ac, em pedaços
+ * paralelos), e opcionalmente compara a saída com uma saída de referência.
+ * Substitui o grep por leitura e a comparação caractere a caractere do E.
+ *
+ * As quebras de linha das saídas são ignoradas, como no E.
+ *
+ * Ex.: ./shsup_verify teste.txt teste2.s teste.s
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+#include "overlap_ac.h"
+#include "read_loader.h"
+#include "read_store.h"
+
+#define MAX_REPORTED 20
+
+/**
+ * @brief Lê um arquivo de saída inteiro, sem as quebras de linha.
+ * * @param path O arquivo.
+ * @param len Recebe o comprimento do texto.
+ * @return O texto (termina em '\0'), ou NULL em caso de erro (a causa é impressa).
+ */
+static char* load_output(const char* path, size_t* len) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+        perror(path);
+        return NULL;
+    }
+    size_t capacity = 1 << 16;
+    size_t size = 0;
+    char* text = malloc(capacity);
+    for (;;) {
+        if (text == NULL) {
+            perror("Falha ao alocar memória em load_output");
+            exit(EXIT_FAILURE);
+        }
+        size_t got = fread(text + size, 1, capacity - size, f);
+        size += got;
+        if (size < capacity) break;
+        capacity *= 2;
+        text = realloc(text, capacity);
+    }
+    bool failed = ferror(f);
+    fclose(f);
+    if (failed) {
+        perror(path);
+        free(text);
+        return NULL;
+    }
+
+    size_t out = 0;
+    for (size_t k = 0; k < size; ++k) {
+        if (text[k] != '\n' && text[k] != '\r') text[out++] = text[k];
+    }
+    text[out] = '\0';
+    *len = out;
+    return text;
+}
+
+static void print_usage(const char* program) {
+    fprintf(stderr,
+            "Uso: %s leituras saída [referência]\n"
+            "  leituras     entrada do resolvedor (contagem + leituras, FASTA ou FASTQ)\n"
+            "  saída        superstring produzida\n"
+            "  referência   outra saída, que deve ser idêntica (ex.: a do sequencial)\n",
+            program);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3 || argc > 4) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    const char* reads_path = argv[1];
+    const char* output_path = argv[2];
+    const char* reference_path = argc == 4 ? argv[3] : NULL;
+
+    double t_start = omp_get_wtime();
+
+    read_store_t store;
+    if (!read_loader_load(reads_path, &store, NULL)) return 1;
+    size_t text_len;
+    char* text = load_output(output_path, &text_len);
+    if (text == NULL) {
+        read_store_free(&store);
+        return 1;
+    }
+
+    int n = store.count;
+    char** strings = malloc((n + 1) * sizeof(char*));
+    int* lens = malloc((n + 1) * sizeof(int));
+    size_t input_len = 0;
+    for (int i = 0; i < n; ++i) {
+        strings[i] = read_store_get(&store, i);
+        lens[i] = store.len[i];
+        input_len += lens[i];
+    }
+
+    // --- leituras ausentes: uma passada do autômato sobre a saída ---
+    bool* found = strings_in_text_ac(strings, lens, n, text, text_len, true);
+    int missing = 0;
+    for (int i = 0; i < n; ++i) {
+        if (found[i]) continue;
+        if (missing < MAX_REPORTED) printf("Leitura %d NÃO encontrada em %s: %s\n", i + 1, output_path, strings[i]);
+        missing++;
+    }
+    if (missing > MAX_REPORTED) printf("... e mais %d leituras ausentes\n", missing - MAX_REPORTED);
+    printf("Leituras: %d (%d encontradas, %d ausentes)\n", n, n - missing, missing);
+    printf("Comprimento: %zu bases nas leituras, %zu na saída (compressão %.3fx)\n",
+           input_len, text_len, text_len > 0 ? (double)input_len / text_len : 0.0);
+
+    // --- comparação com a referência ---
+    bool identical = true;
+    if (reference_path != NULL) {
+        size_t reference_len;
+        char* reference = load_output(reference_path, &reference_len);
+        if (reference == NULL) {
+            identical = false;
+        } else {
+            size_t common = text_len < reference_len ? text_len : reference_len;
+            size_t k = 0;
+            while (k < common && text[k] == reference[k]) k++;
+            identical = (k == common && text_len == reference_len);
+            if (identical) {
+                printf("Referência: idêntica a %s\n", reference_path);
+            } else {
+                printf("Referência: difere de %s na posição %zu (comprimentos %zu e %zu)\n",
+                       reference_path, k + 1, text_len, reference_len);
+            }
+            free(reference);
+        }
+    }
+
+    fprintf(stderr, "Tempo da verificação: %.6f segundos\n", omp_get_wtime() - t_start);
+
+    free(found);
+    free(strings);
+    free(lens);
+    free(text);
+    read_store_free(&store);
+    return (missing == 0 && identical) ? 0 : 1;
+}